@@ -0,0 +1,60 @@
+#include "barcode_alloc.h"
+
+#ifdef BARCODE_DEBUG
+
+#include <stdatomic.h>
+
+//the size of an allocation is stored in front of it, the header keeps the 8 byte alignment of malloc
+typedef union {
+    size_t size;
+    uint64_t align;
+} AllocHeader;
+
+//the barcodes are allocated on the load thread and the GUI thread, so the counters are atomic
+static atomic_uint_least32_t alloc_count;
+static atomic_uint_least32_t free_count;
+static atomic_size_t bytes_in_use;
+static atomic_size_t peak_bytes;
+
+void* barcode_alloc(size_t size) {
+    AllocHeader* header = malloc(sizeof(AllocHeader) + size);
+    if(header == NULL) {
+        return NULL;
+    }
+    header->size = size;
+
+    atomic_fetch_add(&alloc_count, 1);
+    size_t in_use = atomic_fetch_add(&bytes_in_use, size) + size;
+    size_t peak = atomic_load(&peak_bytes);
+    while(in_use > peak && !atomic_compare_exchange_weak(&peak_bytes, &peak, in_use)) {
+        //peak is now the peak of another thread, compared again
+    }
+    return header + 1;
+}
+
+void barcode_alloc_free(void* ptr) {
+    if(ptr == NULL) {
+        return;
+    }
+    AllocHeader* header = (AllocHeader*)ptr - 1;
+
+    atomic_fetch_add(&free_count, 1);
+    atomic_fetch_sub(&bytes_in_use, header->size);
+    free(header);
+}
+
+void barcode_alloc_get_stats(BarcodeAllocStats* stats) {
+    stats->allocs = atomic_load(&alloc_count);
+    stats->frees = atomic_load(&free_count);
+    stats->bytes_in_use = atomic_load(&bytes_in_use);
+    stats->peak_bytes = atomic_load(&peak_bytes);
+}
+
+/**
+ * Starts tracking the peak from the bytes that are in use now
+*/
+void barcode_alloc_reset_peak() {
+    atomic_store(&peak_bytes, atomic_load(&bytes_in_use));
+}
+
+#endif
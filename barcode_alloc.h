@@ -0,0 +1,41 @@
+#pragma once
+
+/**
+ * Allocation accounting, part of the encoding core so it only uses the C standard library
+ * The barcodes are allocated with barcode_alloc and barcode_alloc_free, debug builds count the allocations
+ * and the bytes in use, release builds call malloc and free directly
+ * Only these calls are counted, the allocations of the views, the debug tools and the firmware
+ * (FuriString, FlipperFormat, ...) are not, the file read is measured on the heap instead, see
+ * barcode_debug_memory_sample
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+//the debug tools (benchmarks, traces, overlays) are only compiled into debug builds (./fbt DEBUG=1)
+#if defined(FURI_DEBUG) && !defined(BARCODE_DEBUG)
+#define BARCODE_DEBUG
+#endif
+
+typedef struct {
+    uint32_t allocs; //the number of allocations made so far
+    uint32_t frees; //the number of frees made so far
+    size_t bytes_in_use; //the bytes of all allocations that have not been freed
+    size_t peak_bytes; //the most bytes in use since the last barcode_alloc_reset_peak
+} BarcodeAllocStats;
+
+#ifdef BARCODE_DEBUG
+
+void* barcode_alloc(size_t size);
+void barcode_alloc_free(void* ptr);
+void barcode_alloc_get_stats(BarcodeAllocStats* stats);
+void barcode_alloc_reset_peak();
+
+#else
+
+#define barcode_alloc(size) malloc(size)
+#define barcode_alloc_free(ptr) free(ptr)
+
+#endif
@@ -35,30 +35,45 @@ static bool select_file(const char* folder, FuriString* file_path) {
  * Reads the data from a file and stores them in the FuriStrings raw_type and raw_data
 */
 ErrorCode read_raw_data(FuriString* file_path, FuriString* raw_type, FuriString* raw_data) {
+    barcode_trace_begin(BarcodeTraceReadFile, BARCODE_TRACE_NO_TYPE, 0);
+
     //Open Storage
     Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* ff = flipper_format_file_alloc(storage);
 
     ErrorCode reason = OKCode;
 
-    if(!flipper_format_file_open_existing(ff, furi_string_get_cstr(file_path))) {
-        FURI_LOG_E(TAG, "Could not open file %s", furi_string_get_cstr(file_path));
+    //a file that is too large is rejected before any of it is read into the strings
+    FileInfo file_info;
+    if(storage_common_stat(storage, furi_string_get_cstr(file_path), &file_info) == FSE_OK &&
+       file_info.size > BARCODE_MAX_FILE_SIZE) {
+        BARCODE_LOG_E(
+            "File %s is %lu bytes, the limit is %d",
+            furi_string_get_cstr(file_path),
+            (unsigned long)file_info.size,
+            BARCODE_MAX_FILE_SIZE);
+        reason = InvalidFileData;
+    } else if(!flipper_format_file_open_existing(ff, furi_string_get_cstr(file_path))) {
+        BARCODE_LOG_E("Could not open file %s", furi_string_get_cstr(file_path));
         reason = FileOpening;
     } else {
         if(!flipper_format_read_string(ff, "Type", raw_type)) {
-            FURI_LOG_E(TAG, "Could not read \"Type\" string");
+            BARCODE_LOG_E("Could not read \"Type\" string");
             reason = InvalidFileData;
         }
         if(!flipper_format_read_string(ff, "Data", raw_data)) {
-            FURI_LOG_E(TAG, "Could not read \"Data\" string");
+            BARCODE_LOG_E("Could not read \"Data\" string");
             reason = InvalidFileData;
         }
     }
+    //the file is still open and the strings are read, the most the read holds on the heap
+    barcode_debug_memory_sample(BarcodeDebugPhaseReadFile);
 
     //Close Storage
     flipper_format_free(ff);
     furi_record_close(RECORD_STORAGE);
 
+    barcode_trace_end(BarcodeTraceReadFile, BARCODE_TRACE_NO_TYPE, furi_string_size(raw_data));
     return reason;
 }
 
@@ -94,65 +109,249 @@ bool get_file_name_from_path(FuriString* file_path, FuriString* file_name, bool
 */
 void init_folder() {
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    FURI_LOG_I(TAG, "Creating barcodes folder");
+    BARCODE_LOG_I("Creating barcodes folder");
     if(storage_simply_mkdir(storage, DEFAULT_USER_BARCODES)) {
-        FURI_LOG_I(TAG, "Barcodes folder successfully created!");
+        BARCODE_LOG_I("Barcodes folder successfully created!");
     } else {
-        FURI_LOG_I(TAG, "Barcodes folder already exists.");
+        BARCODE_LOG_I("Barcodes folder already exists.");
     }
     furi_record_close(RECORD_STORAGE);
 }
 
-void select_barcode_item(BarcodeApp* app) {
-    FuriString* file_path = furi_string_alloc();
+/**
+ * Validates and encodes a barcode, nothing is locked so this can run on the load thread
+ * @param reason  OKCode if raw_type and raw_data were read, otherwise why they could not be read
+ * @returns the barcode data, free it with barcode_data_free if it isn't given to the barcode view
+*/
+BarcodeData* barcode_data_alloc(FuriString* raw_type, FuriString* raw_data, ErrorCode reason) {
+    //this determines if the data was read correctly or if the
+    bool loaded_success = reason == OKCode;
+
+    barcode_debug_memory_begin(BarcodeDebugPhaseValidate);
+    BarcodeData* data = barcode_alloc(sizeof(BarcodeData));
+    data->valid = loaded_success;
+    data->modules = NULL;
+    data->runs.widths = NULL;
+    data->runs.count = 0;
+
+    if(loaded_success) {
+        data->raw_data = barcode_debug_string_allocated(furi_string_alloc_set(raw_data));
+        data->correct_data = barcode_debug_string_allocated(furi_string_alloc());
+
+        data->type_obj = get_type(raw_type);
+        barcode_debug_memory_end(BarcodeDebugPhaseValidate);
+
+        barcode_debug_memory_begin(BarcodeDebugPhaseEncode);
+        barcode_loader(data);
+        barcode_debug_memory_end(BarcodeDebugPhaseEncode);
+    } else {
+        data->raw_data = NULL;
+        data->correct_data = NULL;
+        data->reason = reason;
+        barcode_debug_memory_end(BarcodeDebugPhaseValidate);
+    }
+    return data;
+}
+
+void barcode_data_free(BarcodeData* data) {
+    if(data == NULL) {
+        return;
+    }
+    if(data->raw_data != NULL) {
+        barcode_debug_string_freed();
+        furi_string_free(data->raw_data);
+    }
+    if(data->correct_data != NULL) {
+        barcode_debug_string_freed();
+        furi_string_free(data->correct_data);
+    }
+    if(data->modules != NULL) {
+        module_buffer_free(data->modules);
+    }
+    barcode_alloc_free(data->runs.widths);
+    barcode_alloc_free(data);
+}
+
+/**
+ * Replaces the barcode of the barcode view, the previous barcode is freed
+ * @param reason  OKCode if raw_type and raw_data were read, otherwise why they could not be read
+*/
+void set_barcode_data(
+    Barcode* barcode,
+    FuriString* file_path,
+    FuriString* raw_type,
+    FuriString* raw_data,
+    ErrorCode reason) {
+    barcode_set_data(barcode, file_path, barcode_data_alloc(raw_type, raw_data, reason));
+}
+
+/**
+ * Reads a barcode file, then validates and encodes the barcode
+ * @param cancelled  the barcode isn't encoded if this is true after the file is read, NULL if the read
+ * can't be cancelled
+ * @returns the barcode data or NULL if it was cancelled
+*/
+static BarcodeData* read_barcode_data(FuriString* file_path, const atomic_bool* cancelled) {
     FuriString* raw_type = furi_string_alloc();
     FuriString* raw_data = furi_string_alloc();
 
-    //this determines if the data was read correctly or if the
-    bool loaded_success = true;
-    ErrorCode reason = OKCode;
+    barcode_debug_memory_begin(BarcodeDebugPhaseReadFile);
+    ErrorCode reason = read_raw_data(file_path, raw_type, raw_data);
+    barcode_debug_memory_end(BarcodeDebugPhaseReadFile);
+    if(reason != OKCode) {
+        BARCODE_LOG_E("Could not read data correctly");
+    }
 
-    bool file_selected = select_file(DEFAULT_USER_BARCODES, file_path);
-    if(file_selected) {
-        FURI_LOG_I(TAG, "The file selected is %s", furi_string_get_cstr(file_path));
-        Barcode* barcode = app->barcode_view;
+    BarcodeData* data = NULL;
+    if(cancelled == NULL || !atomic_load(cancelled)) {
+        data = barcode_data_alloc(raw_type, raw_data, reason);
+    }
 
-        reason = read_raw_data(file_path, raw_type, raw_data);
-        if(reason != OKCode) {
-            loaded_success = false;
-            FURI_LOG_E(TAG, "Could not read data correctly");
-        }
+    furi_string_free(raw_type);
+    furi_string_free(raw_data);
+    return data;
+}
+
+/**
+ * Reads a barcode file and loads it into the barcode view, the previous barcode is freed
+ * @param file_path  the path of the barcode file
+*/
+void load_barcode(BarcodeApp* app, FuriString* file_path) {
+    barcode_set_data(app->barcode_view, file_path, read_barcode_data(file_path, NULL));
+}
+
+static int32_t barcode_load_thread(void* context) {
+    BarcodeLoad* load = context;
+
+    load->data = read_barcode_data(load->file_path, &load->cancelled);
+    view_dispatcher_send_custom_event(
+        load->view_dispatcher, barcode_event(BarcodeLoadedEvent, load->id));
+    return 0;
+}
+
+/**
+ * Waits for the load thread to finish and frees the load
+ * @returns the loaded barcode data, NULL if the load was cancelled
+*/
+static BarcodeData* barcode_load_free(BarcodeLoad* load) {
+    furi_thread_join(load->thread);
+    furi_thread_free(load->thread);
+
+    BarcodeData* data = load->data;
+    if(atomic_load(&load->cancelled)) {
+        barcode_data_free(data);
+        data = NULL;
+    }
 
-        //Free the data from the previous barcode
-        barcode_free_model(barcode);
+    furi_string_free(load->file_path);
+    free(load);
+    return data;
+}
+
+/**
+ * Starts loading a barcode file on the load thread, the barcode view shows that it is loading until
+ * the load thread sends BarcodeLoadedEvent
+ * @param file_path  the path of the barcode file
+*/
+void barcode_load_start(BarcodeApp* app, FuriString* file_path) {
+    //a load that is still running is cancelled and freed when its BarcodeLoadedEvent comes, joining it
+    //here would block the dispatcher until its file is read
+    //the trace of the new selection has begun, so the trace of a load that was not cancelled isn't ended
+    if(app->load != NULL) {
+        atomic_store(&app->load->cancelled, true);
+        app->load->next = app->replaced_loads;
+        app->replaced_loads = app->load;
+    }
 
-        with_view_model(
-            barcode->view,
-            BarcodeModel * model,
-            {
-                model->file_path = furi_string_alloc_set(file_path);
+    BarcodeLoad* load = malloc(sizeof(BarcodeLoad));
+    load->view_dispatcher = app->view_dispatcher;
+    load->id = app->load_count++;
+    load->file_path = furi_string_alloc_set(file_path);
+    load->data = NULL;
+    atomic_init(&load->cancelled, false);
+    load->next = NULL;
+    load->thread = furi_thread_alloc_ex(
+        "BarcodeLoad", BARCODE_LOAD_STACK_SIZE, barcode_load_thread, load);
+    app->load = load;
+
+    barcode_set_loading(app->barcode_view, true);
+    furi_thread_start(load->thread);
+}
 
-                model->data = malloc(sizeof(BarcodeData));
-                model->data->valid = loaded_success;
+/**
+ * Cancels the load in flight, called when the user leaves the barcode view while it is loading
+*/
+void barcode_load_cancel(BarcodeApp* app) {
+    if(app->load != NULL && !atomic_exchange(&app->load->cancelled, true)) {
+        barcode_trace_end(BarcodeTraceSelect, BARCODE_TRACE_NO_TYPE, 0);
+    }
+    barcode_set_loading(app->barcode_view, false);
+}
 
-                if(loaded_success) {
-                    model->data->raw_data = furi_string_alloc_set(raw_data);
-                    model->data->correct_data = furi_string_alloc();
+/**
+ * Waits for every load that is still running and frees them, called when the app exits
+*/
+static void barcode_load_free_all(BarcodeApp* app) {
+    if(app->load != NULL) {
+        barcode_data_free(barcode_load_free(app->load));
+        app->load = NULL;
+    }
+    while(app->replaced_loads != NULL) {
+        BarcodeLoad* load = app->replaced_loads;
+        app->replaced_loads = load->next;
+        barcode_data_free(barcode_load_free(load));
+    }
+}
 
-                    model->data->type_obj = get_type(raw_type);
+bool custom_event_callback(void* context, uint32_t event) {
+    furi_assert(context);
+    BarcodeApp* app = context;
 
-                    barcode_loader(model->data);
-                } else {
-                    model->data->reason = reason;
+    if(barcode_event_type(event) == BarcodeLoadedEvent) {
+        //a load that was replaced by the next barcode_load_start sent the event just before its thread
+        //returns, so it is joined without waiting for a file read
+        uint32_t id = barcode_event_value(event);
+        if(app->load == NULL || app->load->id != id) {
+            for(BarcodeLoad** load = &app->replaced_loads; *load != NULL; load = &(*load)->next) {
+                if((*load)->id == id) {
+                    BarcodeLoad* replaced = *load;
+                    *load = replaced->next;
+                    barcode_data_free(barcode_load_free(replaced));
+                    break;
                 }
-            },
-            true);
+            }
+            return true;
+        }
+
+        //loads are only cancelled on the dispatcher thread, so the load can't be cancelled after
+        //barcode_load_free checked it and before the data is exchanged
+        //a cancelled load ended its trace when it was cancelled
+        BarcodeLoad* load = app->load;
+        app->load = NULL;
+        FuriString* file_path = furi_string_alloc_set(load->file_path);
+        BarcodeData* data = barcode_load_free(load);
+        if(data != NULL) {
+            barcode_set_data(app->barcode_view, file_path, data);
+            barcode_trace_end(BarcodeTraceSelect, BARCODE_TRACE_NO_TYPE, 0);
+        }
+        furi_string_free(file_path);
+        return true;
+    }
+    return false;
+}
+
+void select_barcode_item(BarcodeApp* app) {
+    FuriString* file_path = furi_string_alloc();
+
+    bool file_selected = select_file(DEFAULT_USER_BARCODES, file_path);
+    if(file_selected) {
+        BARCODE_LOG_I("The file selected is %s", furi_string_get_cstr(file_path));
+        barcode_trace_begin(BarcodeTraceSelect, BARCODE_TRACE_NO_TYPE, 0);
+        barcode_load_start(app, file_path);
 
         view_dispatcher_switch_to_view(app->view_dispatcher, BarcodeView);
     }
 
-    furi_string_free(raw_type);
-    furi_string_free(raw_data);
     furi_string_free(file_path);
 }
 
@@ -167,12 +366,12 @@ void edit_barcode_item(BarcodeApp* app) {
 
     bool file_selected = select_file(DEFAULT_USER_BARCODES, file_path);
     if(file_selected) {
-        FURI_LOG_I(TAG, "The file selected is %s", furi_string_get_cstr(file_path));
+        BARCODE_LOG_I("The file selected is %s", furi_string_get_cstr(file_path));
         CreateView* create_view_object = app->create_view;
 
         reason = read_raw_data(file_path, raw_type, raw_data);
         if(reason != OKCode) {
-            FURI_LOG_E(TAG, "Could not read data correctly");
+            BARCODE_LOG_E("Could not read data correctly");
             with_view_model(
                 app->message_view->view,
                 MessageViewModel * model,
@@ -183,9 +382,9 @@ void edit_barcode_item(BarcodeApp* app) {
                 create_view_object->barcode_app->view_dispatcher, MessageErrorView);
 
         } else {
-            BarcodeTypeObj* type_obj = get_type(raw_type);
+            const BarcodeTypeObj* type_obj = get_type(raw_type);
             if(type_obj->type == UNKNOWN) {
-                type_obj = barcode_type_objs[0];
+                type_obj = &barcode_type_objs[0];
             }
             get_file_name_from_path(file_path, file_name, true);
 
@@ -222,7 +421,7 @@ void create_barcode_item(BarcodeApp* app) {
         CreateViewModel * model,
         {
             model->selected_menu_item = 0;
-            model->barcode_type = barcode_type_objs[0];
+            model->barcode_type = &barcode_type_objs[0];
             model->file_path = furi_string_alloc();
             model->file_name = furi_string_alloc();
             model->barcode_data = furi_string_alloc();
@@ -248,6 +447,12 @@ void submenu_callback(void* context, uint32_t index) {
     } else if(index == ErrorCodesWidgetItem) {
         view_dispatcher_switch_to_view(app->view_dispatcher, ErrorCodesWidgetView);
     }
+#ifdef BARCODE_DEBUG
+    else if(index == BenchWidgetItem) {
+        barcode_debug_bench_menu(app);
+        view_dispatcher_switch_to_view(app->view_dispatcher, BenchWidgetView);
+    }
+#endif
 }
 
 uint32_t create_view_callback(void* context) {
@@ -266,10 +471,12 @@ uint32_t exit_callback(void* context) {
 }
 
 void free_app(BarcodeApp* app) {
-    FURI_LOG_I(TAG, "Freeing Data");
+    BARCODE_LOG_I("Freeing Data");
+
+    //the load threads use the view dispatcher and the barcode view
+    barcode_load_free_all(app);
 
     init_folder();
-    free_types();
 
     view_dispatcher_remove_view(app->view_dispatcher, TextInputView);
     text_input_free(app->text_input);
@@ -280,6 +487,11 @@ void free_app(BarcodeApp* app) {
     view_dispatcher_remove_view(app->view_dispatcher, ErrorCodesWidgetView);
     widget_free(app->error_codes_widget);
 
+#ifdef BARCODE_DEBUG
+    view_dispatcher_remove_view(app->view_dispatcher, BenchWidgetView);
+    widget_free(app->bench_widget);
+#endif
+
     view_dispatcher_remove_view(app->view_dispatcher, MessageErrorView);
     message_view_free(app->message_view);
 
@@ -311,15 +523,27 @@ void set_backlight_brightness(float brightness) {
 
 int32_t barcode_main(void* p) {
     UNUSED(p);
+#ifdef BARCODE_DEBUG
+    if(p != NULL && strcmp(p, BARCODE_BENCH_ARGS) == 0) {
+        init_folder();
+        barcode_debug_bench();
+        return 0;
+    }
+#endif
     BarcodeApp* app = malloc(sizeof(BarcodeApp));
-    init_types();
     app->event_queue = furi_message_queue_alloc(8, sizeof(InputEvent));
 
     // Register view port in GUI
     app->gui = furi_record_open(RECORD_GUI);
 
+    app->load = NULL;
+    app->load_count = 0;
+    app->replaced_loads = NULL;
+
     app->view_dispatcher = view_dispatcher_alloc();
     view_dispatcher_enable_queue(app->view_dispatcher);
+    view_dispatcher_set_event_callback_context(app->view_dispatcher, app);
+    view_dispatcher_set_custom_event_callback(app->view_dispatcher, custom_event_callback);
     view_dispatcher_attach_to_gui(app->view_dispatcher, app->gui, ViewDispatcherTypeFullscreen);
 
     app->main_menu = submenu_alloc();
@@ -376,7 +600,7 @@ int32_t barcode_main(void* p) {
         "UPC-A: 11-12 characters\n"
         "EAN-8: 7-8 characters\n"
         "EAN-13: 12-13 characters\n"
-        "Code128C - even # of \ncharacters\n"
+        "Code128C: 2 or more digits,\nan odd # of digits is ok\n"
         "\n"
         "\e#Invalid Characters\n"
         "The barcode data has invalid \ncharacters.\n"
@@ -390,12 +614,6 @@ int32_t barcode_main(void* p) {
         "\n"
         "\e#Invalid File Data\n"
         "The barcode file could not find the keys \"Type\" or \"Data\". \nThis usually occurs when you edit the file manually and \naccidently change the keys\n"
-        "\n"
-        "\e#Missing Encoding Table\n"
-        "The encoding table files are \nmissing. This only occurs \nwhen you need to handle the \nencoding files manually. If you \ndownload the files from the \napp store this should not \noccur\n"
-        "\n"
-        "\e#Encoding Table Error\n"
-        "This occurs when the \nprogram cannot find a \ncharacter in the encoding \ntable, meaning that either the\ncharacter isn't supported \nor the character is missing \nfrom the encoding table\n"
         "");
     view_set_previous_callback(widget_get_view(app->error_codes_widget), main_menu_callback);
     view_dispatcher_add_view(
@@ -403,6 +621,17 @@ int32_t barcode_main(void* p) {
     submenu_add_item(
         app->main_menu, "Error Codes Info", ErrorCodesWidgetItem, submenu_callback, app);
 
+#ifdef BARCODE_DEBUG
+    /*****************************
+     * Creating Benchmark View
+     ******************************/
+    app->bench_widget = widget_alloc();
+    view_set_previous_callback(widget_get_view(app->bench_widget), main_menu_callback);
+    view_dispatcher_add_view(
+        app->view_dispatcher, BenchWidgetView, widget_get_view(app->bench_widget));
+    submenu_add_item(app->main_menu, "Benchmark", BenchWidgetItem, submenu_callback, app);
+#endif
+
     /*****************************
      * Creating About View
      ******************************/
@@ -438,7 +667,32 @@ int32_t barcode_main(void* p) {
 
     //switch view to submenu and run dispatcher
     view_dispatcher_switch_to_view(app->view_dispatcher, MainMenuView);
+#ifdef BARCODE_DEBUG
+    if(p != NULL && strcmp(p, BARCODE_STACK_ARGS) == 0) {
+        init_folder();
+        barcode_debug_stack(app);
+    } else if(p != NULL && strcmp(p, BARCODE_FRAMES_ARGS) == 0) {
+        init_folder();
+        barcode_debug_frames(app);
+    } else if(p != NULL && strcmp(p, BARCODE_GOLDEN_ARGS) == 0) {
+        barcode_debug_golden(app);
+    } else if(p != NULL && strcmp(p, BARCODE_ROUNDTRIP_ARGS) == 0) {
+        init_folder();
+        barcode_debug_roundtrip(app);
+    } else if(p != NULL && strcmp(p, BARCODE_FUZZ_ARGS) == 0) {
+        init_folder();
+        barcode_debug_fuzz(app);
+    } else if(p != NULL && strcmp(p, BARCODE_REPLAY_ARGS) == 0) {
+        init_folder();
+        BarcodeDebugReplay* replay = barcode_debug_replay_start(app);
+        view_dispatcher_run(app->view_dispatcher);
+        barcode_debug_replay_free(replay);
+    } else {
+        view_dispatcher_run(app->view_dispatcher);
+    }
+#else
     view_dispatcher_run(app->view_dispatcher);
+#endif
 
     free_app(app);
     notification_message_block(notifications, &sequence_display_backlight_enforce_auto);
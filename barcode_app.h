@@ -11,6 +11,7 @@
 #include <gui/modules/widget.h>
 #include "keyboard/text_input.h"
 #include <flipper_format/flipper_format.h>
+#include <stdatomic.h>
 
 #include "barcode_utils.h"
 
@@ -20,20 +21,21 @@
 
 #define TEXT_BUFFER_SIZE 128
 
-#define BARCODE_HEIGHT 50
-#define BARCODE_Y_START 3
+//the most characters of data a barcode can have when it is loaded, longer data can't fit on the screen
+//and only makes the loader allocate more
+#define BARCODE_MAX_DATA_LENGTH 256
 
-//the folder where the codabar encoding table is located
-#define CODABAR_DICT_FILE_PATH APP_ASSETS_PATH("codabar_encodings.txt")
+//the largest barcode file that is read, a file with BARCODE_MAX_DATA_LENGTH characters of data is much smaller
+#define BARCODE_MAX_FILE_SIZE 1024
 
-//the folder where the code 39 encoding table is located
-#define CODE39_DICT_FILE_PATH APP_ASSETS_PATH("code39_encodings.txt")
+#define BARCODE_HEIGHT 50
+#define BARCODE_Y_START 3
 
-//the folder where the code 128 encoding table is located
-#define CODE128_DICT_FILE_PATH APP_ASSETS_PATH("code128_encodings.txt")
+//guard bars (EAN-8, EAN-13, UPC-A) are drawn longer than the rest of the bars
+#define BARCODE_GUARD_HEIGHT (BARCODE_HEIGHT + 5)
 
-//the folder where the code 128 C encoding table is located
-#define CODE128C_DICT_FILE_PATH APP_ASSETS_PATH("code128c_encodings.txt")
+//the number of bytes in one 128 pixel row of the barcode, 1 bit per pixel
+#define BARCODE_ROW_BYTES (128 / 8)
 
 //the folder where the user stores their barcodes
 #define DEFAULT_USER_BARCODES EXT_PATH("apps_data/barcodes")
@@ -46,10 +48,29 @@
 #include "views/create_view.h"
 #include "views/message_view.h"
 #include "barcode_validator.h"
+#include "barcode_debug.h"
+#include "barcode_trace.h"
+#include "barcode_log.h"
 extern const Icon I_barcode_10;
 
 typedef struct BarcodeApp BarcodeApp;
 
+//the stack of the thread barcodes are loaded on, the same as the app stack that loaded them before
+#define BARCODE_LOAD_STACK_SIZE (2 * 1024)
+
+/**
+ * A barcode file that is read, validated and encoded on the load thread
+*/
+typedef struct BarcodeLoad {
+    FuriThread* thread;
+    ViewDispatcher* view_dispatcher; //BarcodeLoadedEvent is sent to it
+    uint32_t id; //sent with BarcodeLoadedEvent, so the event of an earlier load can be told apart
+    FuriString* file_path;
+    BarcodeData* data; //the loaded barcode, set by the load thread before it sends BarcodeLoadedEvent
+    atomic_bool cancelled; //set when the user leaves the barcode view, the load stops before encoding
+    struct BarcodeLoad* next; //the next load in the replaced loads of the app
+} BarcodeLoad;
+
 struct BarcodeApp {
     Submenu* main_menu;
     ViewDispatcher* view_dispatcher;
@@ -64,6 +85,13 @@ struct BarcodeApp {
     Widget* error_codes_widget;
     MessageView* message_view;
     TextInput* text_input;
+
+    BarcodeLoad* load; //the barcode that is being loaded on the load thread, NULL if there is none
+    uint32_t load_count; //the number of loads that were started, the id of the next load
+    BarcodeLoad* replaced_loads; //cancelled loads still running, freed when their BarcodeLoadedEvent comes
+#ifdef BARCODE_DEBUG
+    Widget* bench_widget;
+#endif
 };
 
 enum SubmenuItems {
@@ -71,9 +99,23 @@ enum SubmenuItems {
     EditBarcodeItem,
     CreateBarcodeItem,
     ErrorCodesWidgetItem,
-    AboutWidgetItem
+    AboutWidgetItem,
+#ifdef BARCODE_DEBUG
+    BenchWidgetItem,
+#endif
+};
+
+enum CustomEvents {
+    BarcodeLoadedEvent, //the load thread is done, the id of the load is sent in the upper bits
 };
 
+//the custom events carry a value, like the id of a load, above the event
+#define BARCODE_EVENT_BITS 8
+#define BARCODE_EVENT_MASK ((1 << BARCODE_EVENT_BITS) - 1)
+#define barcode_event(event, value) ((event) | ((uint32_t)(value) << BARCODE_EVENT_BITS))
+#define barcode_event_type(event) ((event)&BARCODE_EVENT_MASK)
+#define barcode_event_value(event) ((event) >> BARCODE_EVENT_BITS)
+
 enum Views {
     TextInputView,
     AboutWidgetView,
@@ -81,7 +123,10 @@ enum Views {
     MessageErrorView,
     MainMenuView,
     CreateBarcodeView,
-    BarcodeView
+    BarcodeView,
+#ifdef BARCODE_DEBUG
+    BenchWidgetView,
+#endif
 };
 
 void submenu_callback(void* context, uint32_t index);
@@ -90,4 +135,25 @@ uint32_t main_menu_callback(void* context);
 
 uint32_t exit_callback(void* context);
 
-int32_t barcode_main(void* p);
\ No newline at end of file
+bool custom_event_callback(void* context, uint32_t event);
+
+int32_t barcode_main(void* p);
+
+ErrorCode read_raw_data(FuriString* file_path, FuriString* raw_type, FuriString* raw_data);
+
+void set_barcode_data(
+    Barcode* barcode,
+    FuriString* file_path,
+    FuriString* raw_type,
+    FuriString* raw_data,
+    ErrorCode reason);
+
+BarcodeData* barcode_data_alloc(FuriString* raw_type, FuriString* raw_data, ErrorCode reason);
+
+void barcode_data_free(BarcodeData* data);
+
+void load_barcode(BarcodeApp* app, FuriString* file_path);
+
+void barcode_load_start(BarcodeApp* app, FuriString* file_path);
+
+void barcode_load_cancel(BarcodeApp* app);
@@ -0,0 +1,355 @@
+#include "barcode_bench.h"
+#include "barcode_encoder.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Everything a timed op needs, allocated once before the timing starts
+*/
+typedef struct {
+    const BarcodeTypeObj* type_obj;
+    const char* payload;
+    size_t length;
+    size_t modules; //the number of modules of the last encoded barcode
+    ErrorCode result;
+} BenchOpContext;
+
+/**
+ * @returns the number of allocations barcode_alloc made so far, always 0 if they aren't counted
+*/
+static uint32_t bench_allocs() {
+#ifdef BARCODE_DEBUG
+    BarcodeAllocStats stats;
+    barcode_alloc_get_stats(&stats);
+    return stats.allocs;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Does what barcode_loader does with the encoder, the module buffer and scratch are allocated at
+ * the sizes the encoder asks for and freed again, the module buffer of Code 128 at an upper bound
+*/
+static void bench_encode(BenchOpContext* context) {
+    BarcodeType type = context->type_obj->type;
+
+    BarcodeScratch scratch = {.data = NULL, .size = barcode_scratch_size(type, context->length)};
+    if(scratch.size > 0) {
+        scratch.data = barcode_alloc(scratch.size);
+    }
+
+    ModuleBuffer* modules =
+        module_buffer_alloc(barcode_encoded_size(type, context->payload, context->length));
+    context->result = barcode_encode(type, context->payload, context->length, modules, &scratch);
+    context->modules = module_buffer_size(modules);
+
+    module_buffer_free(modules);
+    barcode_alloc_free(scratch.data);
+}
+
+static volatile int bench_check_digit_sink;
+
+static void bench_check_digit(BenchOpContext* context) {
+    bench_check_digit_sink = context->type_obj->check_digit(context->payload, context->length);
+    context->result = OKCode;
+}
+
+/**
+ * Fills the payload with characters that are valid for the type
+ * Code 128 alternates between runs of letters and digits so the code set selection has work to do
+*/
+static void bench_payload(BarcodeType type, char* payload, size_t length) {
+    static const char alphanumeric[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    for(size_t i = 0; i < length; i++) {
+        switch(type) {
+        case CODE39:
+            payload[i] = alphanumeric[i % 36];
+            break;
+        case CODE128:
+            payload[i] = (i / 6) & 1 ? alphanumeric[10 + i % 26] : alphanumeric[i % 10];
+            break;
+        default:
+            payload[i] = '0' + i % 10;
+            break;
+        }
+    }
+    payload[length] = '\0';
+}
+
+/**
+ * Times an op, the op is repeated in growing batches until the batch took atleast min_time_ns
+*/
+static void bench_time(
+    const BarcodeBenchConfig* config,
+    void (*op)(BenchOpContext*),
+    BenchOpContext* context,
+    BarcodeBenchResult* result) {
+    uint32_t iterations = 1;
+    uint64_t elapsed = 0;
+    uint32_t allocs = 0;
+    while(true) {
+        allocs = bench_allocs();
+        uint64_t start = config->clock(config->clock_context);
+        for(uint32_t i = 0; i < iterations; i++) {
+            op(context);
+        }
+        elapsed = config->clock(config->clock_context) - start;
+        allocs = bench_allocs() - allocs;
+
+        if(elapsed >= config->min_time_ns || iterations >= UINT32_MAX / 2) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    result->iterations = iterations;
+    result->ns_per_op = elapsed / iterations;
+    result->allocs_per_op = allocs / iterations;
+    result->modules_per_s = 0;
+    if(result->op == BarcodeBenchEncode && elapsed > 0) {
+        result->modules_per_s = (uint64_t)context->modules * iterations * 1000000000ull / elapsed;
+    }
+    result->result = context->result;
+    result->baseline_ns_per_op = 0;
+    result->regression = false;
+}
+
+/**
+ * Goes through every result of the benchmark, the types with a fixed number of digits are run at their
+ * minimum and maximum number of digits and the other types are run at every power of 2 up to max_length
+ * @param results  the results to fill in, NULL to only count them
+ * @returns the number of results
+*/
+static size_t bench_sweep(
+    const BarcodeBenchConfig* config,
+    char* payload,
+    BarcodeBenchResult* results,
+    size_t max_results) {
+    size_t count = 0;
+    size_t max_length = config->max_length;
+    if(max_length == 0 || max_length > BARCODE_BENCH_MAX_LENGTH) {
+        max_length = BARCODE_BENCH_MAX_LENGTH;
+    }
+
+    for(int i = 0; i < UNKNOWN; i++) {
+        const BarcodeTypeObj* type_obj = &barcode_type_objs[i];
+
+        size_t lengths[16];
+        size_t length_count = 0;
+        if(type_obj->max_digits > 0) {
+            lengths[length_count++] = type_obj->min_digits;
+            lengths[length_count++] = type_obj->max_digits;
+        } else {
+            for(size_t length = type_obj->min_digits; length <= max_length && length_count < 16;
+                length *= 2) {
+                lengths[length_count++] = length;
+            }
+        }
+
+        for(size_t j = 0; j < length_count; j++) {
+            for(int op = BarcodeBenchEncode; op <= BarcodeBenchCheckDigit; op++) {
+                if(op == BarcodeBenchCheckDigit &&
+                   (type_obj->check_digit == NULL || j > 0)) {
+                    continue;
+                }
+                if(results != NULL) {
+                    if(count >= max_results) {
+                        return count;
+                    }
+
+                    BarcodeBenchResult* result = &results[count];
+                    result->type = type_obj->type;
+                    result->op = op;
+                    result->length = lengths[j];
+
+                    bench_payload(type_obj->type, payload, lengths[j]);
+                    BenchOpContext context = {
+                        .type_obj = type_obj, .payload = payload, .length = lengths[j]};
+                    bench_time(
+                        config,
+                        op == BarcodeBenchEncode ? bench_encode : bench_check_digit,
+                        &context,
+                        result);
+                }
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * @returns the number of results barcode_bench_run makes
+*/
+size_t barcode_bench_count(const BarcodeBenchConfig* config) {
+    return bench_sweep(config, NULL, NULL, 0);
+}
+
+/**
+ * Runs the benchmark
+ * @param results  barcode_bench_count results
+ * @returns the number of results that were filled in
+*/
+size_t barcode_bench_run(
+    const BarcodeBenchConfig* config,
+    BarcodeBenchResult* results,
+    size_t max_results) {
+    char* payload = malloc(BARCODE_BENCH_MAX_LENGTH + 1);
+    size_t count = bench_sweep(config, payload, results, max_results);
+    free(payload);
+    return count;
+}
+
+const char* barcode_bench_op_name(BarcodeBenchOp op) {
+    static const char* const names[BarcodeBenchOpCount] = {
+        [BarcodeBenchEncode] = "encode",
+        [BarcodeBenchCheckDigit] = "check_digit",
+        [BarcodeBenchLoad] = "load",
+        [BarcodeBenchDraw] = "draw",
+    };
+    return op < BarcodeBenchOpCount ? names[op] : "unknown";
+}
+
+/**
+ * Reads the string value of a key in a line of the JSON report
+ * @returns the value (not null terminated) and its length or NULL if the line doesn't have the key
+*/
+static const char* json_string(const char* line, const char* key, size_t* length) {
+    const char* value = strstr(line, key);
+    if(value == NULL) {
+        return NULL;
+    }
+    value += strlen(key);
+    const char* end = strchr(value, '"');
+    if(end == NULL) {
+        return NULL;
+    }
+    *length = end - value;
+    return value;
+}
+
+static uint64_t json_number(const char* line, const char* key) {
+    const char* value = strstr(line, key);
+    return value == NULL ? 0 : strtoull(value + strlen(key), NULL, 10);
+}
+
+/**
+ * Compares the results with a report of an earlier run
+ * The baseline is a JSON report from barcode_bench_write_json, it is read one result per line
+ * @param threshold_percent  how much slower a result can be before it is a regression
+ * @returns the number of regressions
+*/
+size_t barcode_bench_compare(
+    BarcodeBenchResult* results,
+    size_t count,
+    const char* baseline,
+    uint32_t threshold_percent) {
+    size_t regressions = 0;
+
+    for(const char* line = baseline; line != NULL && *line != '\0';) {
+        const char* next = strchr(line, '\n');
+
+        size_t name_length = 0;
+        size_t op_length = 0;
+        const char* name = json_string(line, "\"type\":\"", &name_length);
+        const char* op = json_string(line, "\"op\":\"", &op_length);
+
+        if(name != NULL && op != NULL && (next == NULL || name < next)) {
+            const BarcodeTypeObj* type_obj = get_type_by_name(name, name_length);
+            size_t length = json_number(line, "\"length\":");
+            uint64_t baseline_ns = json_number(line, "\"ns_per_op\":");
+
+            for(size_t i = 0; i < count; i++) {
+                BarcodeBenchResult* result = &results[i];
+                const char* result_op = barcode_bench_op_name(result->op);
+                if(result->type != type_obj->type || result->length != length ||
+                   strlen(result_op) != op_length || memcmp(result_op, op, op_length) != 0) {
+                    continue;
+                }
+
+                result->baseline_ns_per_op = baseline_ns;
+                result->regression = result->ns_per_op * 100 >
+                                     baseline_ns * (100 + threshold_percent);
+                regressions += result->regression;
+            }
+        }
+
+        line = next == NULL ? NULL : next + 1;
+    }
+    return regressions;
+}
+
+/**
+ * Writes the results as JSON, one result per line so a report can be used as a baseline
+*/
+void barcode_bench_write_json(
+    const BarcodeBenchResult* results,
+    size_t count,
+    BarcodeBenchWriter writer,
+    void* context) {
+    char line[256];
+    writer(context, "{\"results\":[\n", 13);
+
+    for(size_t i = 0; i < count; i++) {
+        const BarcodeBenchResult* result = &results[i];
+        int length = snprintf(
+            line,
+            sizeof(line),
+            "{\"type\":\"%s\",\"op\":\"%s\",\"length\":%lu,\"iterations\":%lu,\"ns_per_op\":%llu,"
+            "\"modules_per_s\":%llu,\"allocs_per_op\":%lu,\"ok\":%s,\"baseline_ns_per_op\":%llu,"
+            "\"regression\":%s}%s\n",
+            barcode_type_objs[result->type].name,
+            barcode_bench_op_name(result->op),
+            (unsigned long)result->length,
+            (unsigned long)result->iterations,
+            (unsigned long long)result->ns_per_op,
+            (unsigned long long)result->modules_per_s,
+            (unsigned long)result->allocs_per_op,
+            result->result == OKCode ? "true" : "false",
+            (unsigned long long)result->baseline_ns_per_op,
+            result->regression ? "true" : "false",
+            i + 1 < count ? "," : "");
+        if(length > 0) {
+            writer(context, line, (size_t)length < sizeof(line) ? (size_t)length : sizeof(line) - 1);
+        }
+    }
+
+    writer(context, "]}\n", 3);
+}
+
+/**
+ * Writes the results as CSV with a header line, the flipper and a host build write the same columns so
+ * their results can be compared
+*/
+void barcode_bench_write_csv(
+    const BarcodeBenchResult* results,
+    size_t count,
+    BarcodeBenchWriter writer,
+    void* context) {
+    static const char header[] = "type,stage,length,iterations,ns_per_op,us_per_op,allocs_per_op,ok\n";
+    char line[128];
+    writer(context, header, sizeof(header) - 1);
+
+    for(size_t i = 0; i < count; i++) {
+        const BarcodeBenchResult* result = &results[i];
+        int length = snprintf(
+            line,
+            sizeof(line),
+            "%s,%s,%lu,%lu,%llu,%llu.%03llu,%lu,%s\n",
+            barcode_type_objs[result->type].name,
+            barcode_bench_op_name(result->op),
+            (unsigned long)result->length,
+            (unsigned long)result->iterations,
+            (unsigned long long)result->ns_per_op,
+            (unsigned long long)(result->ns_per_op / 1000),
+            (unsigned long long)(result->ns_per_op % 1000),
+            (unsigned long)result->allocs_per_op,
+            result->result == OKCode ? "true" : "false");
+        if(length > 0) {
+            writer(context, line, (size_t)length < sizeof(line) ? (size_t)length : sizeof(line) - 1);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * Benchmarks the encoding core, part of the core so it only uses the C standard library
+ * The caller provides the clock and where the results are written, on the flipper that is the DWT cycle
+ * counter and a file on the SD card
+*/
+
+#include "barcode_types.h"
+
+//the longest payload of the length sweeps
+#define BARCODE_BENCH_MAX_LENGTH 4096
+
+//a result is a regression when it is this many percent slower than the baseline
+#define BARCODE_BENCH_DEFAULT_THRESHOLD 10
+
+typedef enum {
+    BarcodeBenchEncode, //sizes, allocates and encodes a barcode the same way barcode_loader does
+    BarcodeBenchCheckDigit, //calculates the check digit of a barcode type
+    BarcodeBenchLoad, //loads a barcode into the barcode view, only timed on the flipper
+    BarcodeBenchDraw, //draws a loaded barcode, only timed on the flipper
+
+    BarcodeBenchOpCount
+} BarcodeBenchOp;
+
+typedef struct {
+    BarcodeType type;
+    BarcodeBenchOp op;
+    size_t length; //the number of characters in the payload
+    uint32_t iterations; //the number of times the op was timed
+    uint64_t ns_per_op;
+    uint64_t modules_per_s; //0 for ops that don't encode
+    uint32_t allocs_per_op; //counted by barcode_alloc, always 0 in release builds
+    ErrorCode result; //what the encoder returned, anything but OKCode means the payload is wrong
+    uint64_t baseline_ns_per_op; //0 if the baseline has no matching result
+    bool regression; //true if the result is slower than the baseline by more than the threshold
+} BarcodeBenchResult;
+
+/**
+ * @returns a monotonic time in nanoseconds
+*/
+typedef uint64_t (*BarcodeBenchClock)(void* context);
+
+/**
+ * Writes part of the JSON or CSV report
+*/
+typedef void (*BarcodeBenchWriter)(void* context, const char* text, size_t length);
+
+typedef struct {
+    BarcodeBenchClock clock;
+    void* clock_context;
+    uint64_t min_time_ns; //each result is timed for atleast this long
+    size_t max_length; //the longest payload of the length sweeps, up to BARCODE_BENCH_MAX_LENGTH
+} BarcodeBenchConfig;
+
+size_t barcode_bench_count(const BarcodeBenchConfig* config);
+size_t barcode_bench_run(
+    const BarcodeBenchConfig* config,
+    BarcodeBenchResult* results,
+    size_t max_results);
+size_t barcode_bench_compare(
+    BarcodeBenchResult* results,
+    size_t count,
+    const char* baseline,
+    uint32_t threshold_percent);
+void barcode_bench_write_json(
+    const BarcodeBenchResult* results,
+    size_t count,
+    BarcodeBenchWriter writer,
+    void* context);
+void barcode_bench_write_csv(
+    const BarcodeBenchResult* results,
+    size_t count,
+    BarcodeBenchWriter writer,
+    void* context);
+const char* barcode_bench_op_name(BarcodeBenchOp op);
@@ -0,0 +1,1755 @@
+#include "barcode_debug.h"
+
+#include <ctype.h>
+
+#ifdef BARCODE_DEBUG
+
+/**
+ * Extends the 32 bit DWT cycle counter to 64 bits, it overflows about once a minute
+*/
+typedef struct {
+    uint32_t last_cycles;
+    uint64_t cycles;
+} DebugClock;
+
+static uint64_t debug_clock_ns(void* context) {
+    DebugClock* clock = context;
+    uint32_t cycles = DWT->CYCCNT;
+    clock->cycles += (uint32_t)(cycles - clock->last_cycles);
+    clock->last_cycles = cycles;
+    return clock->cycles * 1000 / furi_hal_cortex_instructions_per_microsecond();
+}
+
+static void debug_file_writer(void* context, const char* text, size_t length) {
+    storage_file_write(context, text, length);
+}
+
+/**
+ * Reads a whole text file
+ * @returns the null terminated text that has to be freed, or NULL if the file could not be read
+*/
+static char* debug_read_file(Storage* storage, const char* path) {
+    char* text = NULL;
+    File* file = storage_file_alloc(storage);
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        size_t size = storage_file_size(file);
+        text = malloc(size + 1);
+        text[storage_file_read(file, text, size)] = '\0';
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+    return text;
+}
+
+/**
+ * Runs the benchmark of the encoding core, compares it with the baseline if there is one
+ * and writes the report to the barcodes folder
+ * @returns the number of results that are slower than the baseline
+*/
+size_t barcode_debug_bench() {
+    DebugClock clock = {.last_cycles = DWT->CYCCNT, .cycles = 0};
+    BarcodeBenchConfig config = {
+        .clock = debug_clock_ns,
+        .clock_context = &clock,
+        .min_time_ns = BARCODE_BENCH_MIN_TIME_NS,
+        .max_length = BARCODE_BENCH_MAX_LENGTH,
+    };
+
+    size_t count = barcode_bench_count(&config);
+    BarcodeBenchResult* results = malloc(sizeof(BarcodeBenchResult) * count);
+
+    BARCODE_LOG_I("Running %d benchmarks", (int)count);
+    count = barcode_bench_run(&config, results, count);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    size_t regressions = 0;
+    char* baseline = debug_read_file(storage, BARCODE_BENCH_BASELINE);
+    if(baseline != NULL) {
+        regressions =
+            barcode_bench_compare(results, count, baseline, BARCODE_BENCH_DEFAULT_THRESHOLD);
+        free(baseline);
+    }
+
+    File* file = storage_file_alloc(storage);
+    if(storage_file_open(file, BARCODE_BENCH_REPORT, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        barcode_bench_write_json(results, count, debug_file_writer, file);
+    } else {
+        BARCODE_LOG_E("Could not write %s", BARCODE_BENCH_REPORT);
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+
+    furi_record_close(RECORD_STORAGE);
+    free(results);
+
+    BARCODE_LOG_I("Benchmark done, %d regressions", (int)regressions);
+    return regressions;
+}
+
+/**
+ * A step of using the app that the stack and frame measurements run, on the given canvas if it draws
+*/
+typedef void (*DebugViewStep)(BarcodeApp* app, Canvas* canvas);
+
+static void debug_view_save(BarcodeApp* app, Canvas* canvas) {
+    UNUSED(canvas);
+    save_barcode(app->create_view);
+}
+
+static void debug_view_load(BarcodeApp* app, Canvas* canvas) {
+    UNUSED(canvas);
+    FuriString* file_path = furi_string_alloc_set(BARCODE_DEBUG_FILE_PATH);
+    load_barcode(app, file_path);
+    furi_string_free(file_path);
+}
+
+static void debug_view_barcode_draw(BarcodeApp* app, Canvas* canvas) {
+    View* view = app->barcode_view->view;
+    barcode_draw_callback(canvas, view_get_model(view));
+    view_commit_model(view, false);
+}
+
+static void debug_view_create_draw(BarcodeApp* app, Canvas* canvas) {
+    View* view = app->create_view->view;
+    create_view_draw_callback(canvas, view_get_model(view));
+    view_commit_model(view, false);
+}
+
+//the keys that don't leave the view or open another view
+static const InputKey debug_view_keys[] = {InputKeyUp, InputKeyDown, InputKeyLeft, InputKeyRight};
+
+static void debug_view_barcode_input(BarcodeApp* app, Canvas* canvas) {
+    UNUSED(canvas);
+    for(size_t i = 0; i < COUNT_OF(debug_view_keys); i++) {
+        InputEvent event = {.key = debug_view_keys[i], .type = InputTypePress};
+        barcode_input_callback(&event, app->barcode_view);
+    }
+}
+
+static void debug_view_create_input(BarcodeApp* app, Canvas* canvas) {
+    UNUSED(canvas);
+    for(size_t i = 0; i < COUNT_OF(debug_view_keys); i++) {
+        InputEvent event = {.key = debug_view_keys[i], .type = InputTypePress};
+        create_view_input_callback(&event, app->create_view);
+    }
+}
+
+/**
+ * Fills the data with the most characters the create view allows, or the most digits of the type
+ * The characters are picked so the encoders have the most work, Code 128 switches between code sets
+*/
+static void debug_view_payload(const BarcodeTypeObj* type_obj, FuriString* data) {
+    const char* characters = "0123456789";
+    if(type_obj->type == CODE39) {
+        characters = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ-. $/+%";
+    } else if(type_obj->type == CODE128) {
+        characters = "aB1cD23e4F";
+    } else if(type_obj->type == CODABAR) {
+        characters = "0123456789-$:/.+";
+    }
+
+    size_t length = type_obj->max_digits > 0 ? (size_t)type_obj->max_digits : TEXT_BUFFER_SIZE - 1;
+    size_t count = strlen(characters);
+
+    furi_string_reset(data);
+    for(size_t i = 0; i < length; i++) {
+        furi_string_push_back(data, characters[i % count]);
+    }
+}
+
+/**
+ * Opens the longest barcode of a type in the create view, as if it was being edited
+ * It is saved to BARCODE_DEBUG_FILE_NAME
+*/
+static void debug_view_create(BarcodeApp* app, const BarcodeTypeObj* type_obj) {
+    create_view_free_model(app->create_view);
+    with_view_model(
+        app->create_view->view,
+        CreateViewModel * model,
+        {
+            model->selected_menu_item = 0;
+            model->barcode_type = type_obj;
+            model->file_path = furi_string_alloc();
+            model->file_name = furi_string_alloc_set(BARCODE_DEBUG_FILE_NAME);
+            model->barcode_data = furi_string_alloc();
+            debug_view_payload(type_obj, model->barcode_data);
+            model->mode = EditMode;
+        },
+        false);
+}
+
+static void debug_view_remove_file() {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, BARCODE_DEBUG_FILE_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
+
+/**
+ * Times the load and draw of a barcode, logging is turned down so the log lines aren't timed
+*/
+static void debug_bench_view(
+    BarcodeApp* app,
+    Canvas* canvas,
+    DebugClock* clock,
+    const BarcodeTypeObj* type_obj,
+    BarcodeBenchResult* results) {
+    FuriString* file_path = furi_string_alloc_set("bench");
+    FuriString* type = furi_string_alloc_set(type_obj->name);
+    FuriString* raw_data = furi_string_alloc();
+    debug_view_payload(type_obj, raw_data);
+
+    FuriLogLevel level = furi_log_get_level();
+    furi_log_set_level(FuriLogLevelError);
+
+    BarcodeAllocStats start_stats;
+    BarcodeAllocStats stats;
+    for(int op = BarcodeBenchLoad; op <= BarcodeBenchDraw; op++) {
+        //the first draw builds the render, it isn't part of the time of a frame
+        if(op == BarcodeBenchDraw) {
+            debug_view_barcode_draw(app, canvas);
+        }
+
+        barcode_alloc_get_stats(&start_stats);
+        uint64_t start = debug_clock_ns(clock);
+        for(int i = 0; i < BARCODE_BENCH_MENU_REPEAT; i++) {
+            if(op == BarcodeBenchLoad) {
+                set_barcode_data(app->barcode_view, file_path, type, raw_data, OKCode);
+            } else {
+                debug_view_barcode_draw(app, canvas);
+            }
+        }
+        uint64_t elapsed = debug_clock_ns(clock) - start;
+        barcode_alloc_get_stats(&stats);
+
+        BarcodeBenchResult* result = &results[op - BarcodeBenchLoad];
+        result->type = type_obj->type;
+        result->op = op;
+        result->length = furi_string_size(raw_data);
+        result->iterations = BARCODE_BENCH_MENU_REPEAT;
+        result->ns_per_op = elapsed / BARCODE_BENCH_MENU_REPEAT;
+        result->modules_per_s = 0;
+        result->allocs_per_op = (stats.allocs - start_stats.allocs) / BARCODE_BENCH_MENU_REPEAT;
+        result->result = OKCode;
+        result->baseline_ns_per_op = 0;
+        result->regression = false;
+    }
+
+    with_view_model(
+        app->barcode_view->view,
+        BarcodeModel * model,
+        { results[0].result = model->data->valid ? OKCode : model->data->reason; },
+        false);
+
+    furi_log_set_level(level);
+
+    furi_string_free(file_path);
+    furi_string_free(type);
+    furi_string_free(raw_data);
+}
+
+/**
+ * Runs the benchmark of the Benchmark menu item, the encoding core is timed by barcode_bench_run the
+ * same way a host build times it, then the longest barcode of every type is loaded and drawn
+ * The results are written to BARCODE_BENCH_CSV and shown in the benchmark widget
+ * @returns the number of results
+*/
+size_t barcode_debug_bench_menu(BarcodeApp* app) {
+    DebugClock clock = {.last_cycles = DWT->CYCCNT, .cycles = 0};
+    BarcodeBenchConfig config = {
+        .clock = debug_clock_ns,
+        .clock_context = &clock,
+        .min_time_ns = BARCODE_BENCH_MENU_MIN_TIME_NS,
+        .max_length = BARCODE_BENCH_MENU_MAX_LENGTH,
+    };
+
+    size_t core_count = barcode_bench_count(&config);
+    size_t count = core_count + UNKNOWN * 2;
+    BarcodeBenchResult* results = malloc(sizeof(BarcodeBenchResult) * count);
+    core_count = barcode_bench_run(&config, results, core_count);
+
+    Gui* gui = furi_record_open(RECORD_GUI);
+    Canvas* canvas = gui_direct_draw_acquire(gui);
+    for(int i = 0; i < UNKNOWN; i++) {
+        debug_bench_view(app, canvas, &clock, &barcode_type_objs[i], &results[core_count + i * 2]);
+    }
+    gui_direct_draw_release(gui);
+    furi_record_close(RECORD_GUI);
+    count = core_count + UNKNOWN * 2;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    if(storage_file_open(file, BARCODE_BENCH_CSV, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        barcode_bench_write_csv(results, count, debug_file_writer, file);
+    } else {
+        BARCODE_LOG_E("Could not write %s", BARCODE_BENCH_CSV);
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    //every type gets a heading and a line for each of its results
+    FuriString* text = furi_string_alloc_set("\e#Benchmark us/op\n");
+    for(int i = 0; i < UNKNOWN; i++) {
+        furi_string_cat_printf(text, "\e#%s\n", barcode_type_objs[i].name);
+        for(size_t j = 0; j < count; j++) {
+            const BarcodeBenchResult* result = &results[j];
+            if(result->type != barcode_type_objs[i].type) {
+                continue;
+            }
+            furi_string_cat_printf(
+                text,
+                "%s %lu: %lu.%lu%s\n",
+                barcode_bench_op_name(result->op),
+                (unsigned long)result->length,
+                (unsigned long)(result->ns_per_op / 1000),
+                (unsigned long)(result->ns_per_op % 1000 / 100),
+                result->result == OKCode ? "" : " failed");
+        }
+    }
+    widget_reset(app->bench_widget);
+    widget_add_text_scroll_element(app->bench_widget, 0, 0, 128, 64, furi_string_get_cstr(text));
+    furi_string_free(text);
+
+    free(results);
+
+    BARCODE_LOG_I("Benchmark menu done, %d results", (int)count);
+    return count;
+}
+
+typedef struct {
+    BarcodeApp* app;
+    Canvas* canvas;
+    DebugViewStep step;
+    uint32_t free_bytes; //the least free stack while the step ran
+} DebugStackContext;
+
+static int32_t debug_stack_thread(void* context) {
+    DebugStackContext* stack = context;
+    stack->step(stack->app, stack->canvas);
+    stack->free_bytes = furi_thread_get_stack_space(furi_thread_get_current_id());
+    return 0;
+}
+
+/**
+ * Runs a step on a new thread, FreeRTOS fills the stack of a new thread with a known value
+ * so the deepest the step went is where that value was first overwritten
+ * @returns the most stack the step used in bytes
+*/
+static size_t debug_stack_measure(
+    BarcodeApp* app,
+    Canvas* canvas,
+    const char* type,
+    const char* name,
+    DebugViewStep step) {
+    DebugStackContext context = {.app = app, .canvas = canvas, .step = step, .free_bytes = 0};
+
+    FuriThread* thread = furi_thread_alloc_ex(
+        "BarcodeStack", BARCODE_STACK_MEASURE_SIZE, debug_stack_thread, &context);
+    furi_thread_start(thread);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    size_t used = BARCODE_STACK_MEASURE_SIZE - context.free_bytes;
+    BARCODE_LOG_I(
+        "stack %s %s: %d bytes, %d bytes left",
+        type,
+        name,
+        (int)used,
+        BARCODE_APP_STACK_SIZE - (int)used);
+    return used;
+}
+
+/**
+ * Measures how much stack saving, loading, drawing and the input of the barcode and create views use
+ * for every barcode type with its longest data
+ * The steps run on their own threads with the app and its views, the views are drawn straight to the
+ * screen, and the file the barcodes are saved to is removed again
+ * @returns the most stack any step used in bytes
+*/
+size_t barcode_debug_stack(BarcodeApp* app) {
+    static const struct {
+        const char* name;
+        DebugViewStep step;
+    } steps[] = {
+        {"save", debug_view_save},
+        {"create draw", debug_view_create_draw},
+        {"create input", debug_view_create_input},
+        {"load", debug_view_load},
+        {"barcode draw", debug_view_barcode_draw},
+        {"barcode input", debug_view_barcode_input},
+    };
+
+    Gui* gui = furi_record_open(RECORD_GUI);
+    Canvas* canvas = gui_direct_draw_acquire(gui);
+
+    size_t deepest = 0;
+    for(int i = 0; i < UNKNOWN; i++) {
+        const BarcodeTypeObj* type_obj = &barcode_type_objs[i];
+
+        debug_view_create(app, type_obj);
+
+        for(size_t j = 0; j < COUNT_OF(steps); j++) {
+            size_t used = debug_stack_measure(app, canvas, type_obj->name, steps[j].name, steps[j].step);
+            deepest = MAX(deepest, used);
+        }
+    }
+
+    gui_direct_draw_release(gui);
+    furi_record_close(RECORD_GUI);
+
+    debug_view_remove_file();
+
+    BARCODE_LOG_I("Stack done, deepest step %d of %d bytes", (int)deepest, BARCODE_APP_STACK_SIZE);
+    return deepest;
+}
+
+static const char* const canvas_call_names[BarcodeDebugCanvasCallCount] = {
+    [BarcodeDebugCanvasClear] = "clear",
+    [BarcodeDebugCanvasSetColor] = "set_color",
+    [BarcodeDebugCanvasSetFont] = "set_font",
+    [BarcodeDebugCanvasDrawBox] = "draw_box",
+    [BarcodeDebugCanvasDrawStr] = "draw_str",
+    [BarcodeDebugCanvasDrawXbm] = "draw_xbm",
+    [BarcodeDebugCanvasMultilineText] = "multiline_text",
+};
+
+static uint32_t canvas_calls[BarcodeDebugCanvasCallCount];
+
+void barcode_debug_canvas_call(BarcodeDebugCanvasCall call) {
+    canvas_calls[call]++;
+}
+
+typedef struct {
+    BarcodeApp* app;
+    Canvas* canvas;
+    Storage* storage;
+    File* report;
+    DebugClock clock;
+    bool first; //true until the first line of the report is written
+    uint8_t* pbm; //the frame as a PBM image
+    uint8_t* golden; //the golden frame
+    size_t golden_differs; //the number of frames that differ from their golden frame
+} DebugFrames;
+
+//a binary PBM image of the 128x64 screen
+#define DEBUG_PBM_HEADER "P4\n128 64\n"
+#define DEBUG_PBM_SIZE (sizeof(DEBUG_PBM_HEADER) - 1 + BARCODE_ROW_BYTES * 64)
+
+/**
+ * Converts the frame on the canvas to a binary PBM image
+ * The canvas buffer stores 8 rows per byte with the top row in the least significant bit,
+ * a PBM row stores 8 columns per byte with the leftmost column in the most significant bit
+*/
+static void debug_frames_pbm(Canvas* canvas, uint8_t* pbm) {
+    const uint8_t* buffer = canvas_get_buffer(canvas);
+
+    memcpy(pbm, DEBUG_PBM_HEADER, sizeof(DEBUG_PBM_HEADER) - 1);
+    uint8_t* row = pbm + sizeof(DEBUG_PBM_HEADER) - 1;
+    memset(row, 0, BARCODE_ROW_BYTES * 64);
+    for(size_t y = 0; y < 64; y++, row += BARCODE_ROW_BYTES) {
+        for(size_t x = 0; x < 128; x++) {
+            if(buffer[(y >> 3) * 128 + x] & (1 << (y & 7))) {
+                row[x >> 3] |= 0x80 >> (x & 7);
+            }
+        }
+    }
+}
+
+/**
+ * Writes the frame to the frames folder and compares it with the frame of the same name in the golden folder
+ * @returns "match" or "differs", or "none" if there is no golden frame
+*/
+static const char* debug_frames_write(DebugFrames* frames, const char* name) {
+    debug_frames_pbm(frames->canvas, frames->pbm);
+
+    FuriString* path = furi_string_alloc_printf("%s/%s.pbm", BARCODE_FRAMES_FOLDER, name);
+    File* file = storage_file_alloc(frames->storage);
+    if(storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        storage_file_write(file, frames->pbm, DEBUG_PBM_SIZE);
+    } else {
+        BARCODE_LOG_E("Could not write %s", furi_string_get_cstr(path));
+    }
+    storage_file_close(file);
+
+    const char* golden = "none";
+    furi_string_printf(path, "%s/%s.pbm", BARCODE_FRAMES_GOLDEN, name);
+    if(storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        //read one byte more than a frame so a longer file differs
+        size_t size = storage_file_read(file, frames->golden, DEBUG_PBM_SIZE + 1);
+        bool match = size == DEBUG_PBM_SIZE && memcmp(frames->golden, frames->pbm, size) == 0;
+        golden = match ? "match" : "differs";
+        if(!match) {
+            frames->golden_differs++;
+            BARCODE_LOG_E("frame %s differs from the golden frame", name);
+        }
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_string_free(path);
+    return golden;
+}
+
+/**
+ * Draws a view, counts the canvas calls of the first draw and times the first and the later draws
+ * The frame is written to the frames folder, compared with its golden frame and a line is added to the report
+ * Only the barcode view counts its canvas calls, the calls are left out of the report for the other views,
+ * host/frames.c counts the calls of every view with the canvas of the host SDK
+*/
+static void debug_frames_measure(
+    DebugFrames* frames,
+    const char* view,
+    const char* type,
+    DebugViewStep draw,
+    bool counted) {
+    memset(canvas_calls, 0, sizeof(canvas_calls));
+
+    uint64_t start = debug_clock_ns(&frames->clock);
+    draw(frames->app, frames->canvas);
+    uint64_t first_ns = debug_clock_ns(&frames->clock) - start;
+
+    uint32_t calls[BarcodeDebugCanvasCallCount];
+    memcpy(calls, canvas_calls, sizeof(calls));
+    uint32_t total_calls = 0;
+    for(int i = 0; i < BarcodeDebugCanvasCallCount; i++) {
+        total_calls += calls[i];
+    }
+
+    start = debug_clock_ns(&frames->clock);
+    for(int i = 0; i < BARCODE_FRAMES_REPEAT; i++) {
+        draw(frames->app, frames->canvas);
+    }
+    uint64_t ns_per_frame = (debug_clock_ns(&frames->clock) - start) / BARCODE_FRAMES_REPEAT;
+
+    char line[320];
+    snprintf(line, sizeof(line), "%s_%s", view, type);
+    const char* golden = debug_frames_write(frames, line);
+
+    int length = snprintf(
+        line,
+        sizeof(line),
+        "%s{\"view\":\"%s\",\"type\":\"%s\",\"golden\":\"%s\",\"first_ns\":%llu,"
+        "\"ns_per_frame\":%llu",
+        frames->first ? "" : ",\n",
+        view,
+        type,
+        golden,
+        (unsigned long long)first_ns,
+        (unsigned long long)ns_per_frame);
+    if(counted && length > 0 && (size_t)length < sizeof(line)) {
+        length += snprintf(
+            line + length, sizeof(line) - length, ",\"calls\":%lu", (unsigned long)total_calls);
+    }
+    for(int i = 0;
+        counted && i < BarcodeDebugCanvasCallCount && length > 0 && (size_t)length < sizeof(line);
+        i++) {
+        length += snprintf(
+            line + length,
+            sizeof(line) - length,
+            ",\"%s\":%lu",
+            canvas_call_names[i],
+            (unsigned long)calls[i]);
+    }
+    if(length > 0 && (size_t)length < sizeof(line) - 1) {
+        line[length++] = '}';
+        storage_file_write(frames->report, line, length);
+    }
+    frames->first = false;
+
+    BARCODE_LOG_I(
+        "frame %s %s: %ld calls, first %llu ns, %llu ns per frame",
+        view,
+        type,
+        counted ? (long)total_calls : -1L,
+        (unsigned long long)first_ns,
+        (unsigned long long)ns_per_frame);
+}
+
+static void debug_frames_set_renderer(BarcodeApp* app, BarcodeRenderer renderer) {
+    with_view_model(
+        app->barcode_view->view,
+        BarcodeModel * model,
+        {
+            model->renderer = renderer;
+            model->render.ready = false;
+        },
+        false);
+}
+
+static void debug_view_message_draw(BarcodeApp* app, Canvas* canvas) {
+    View* view = app->message_view->view;
+    message_view_draw_callback(canvas, view_get_model(view));
+    view_commit_model(view, false);
+}
+
+/**
+ * Draws the create, message and barcode views for the longest barcode of every type into the canvas
+ * The canvas calls of the barcode view and the times of every frame are written to the frame report and the frames are written
+ * to the frames folder, the barcode view is drawn with every renderer so they can be compared
+ * Frames that have a frame of the same name in the golden folder are compared with it bit for bit
+ * @returns the number of frames
+*/
+size_t barcode_debug_frames(BarcodeApp* app) {
+    static const struct {
+        const char* name;
+        BarcodeRenderer renderer;
+    } renderers[] = {
+        {"barcode-boxes", BarcodeRendererBoxes},
+        {"barcode-rows", BarcodeRendererRowBitmap},
+    };
+
+    DebugFrames frames = {
+        .app = app,
+        .clock = {.last_cycles = DWT->CYCCNT, .cycles = 0},
+        .first = true,
+        .pbm = malloc(DEBUG_PBM_SIZE),
+        .golden = malloc(DEBUG_PBM_SIZE + 1),
+        .golden_differs = 0,
+    };
+
+    Gui* gui = furi_record_open(RECORD_GUI);
+    frames.canvas = gui_direct_draw_acquire(gui);
+    frames.storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_mkdir(frames.storage, BARCODE_FRAMES_FOLDER);
+
+    size_t count = 0;
+    frames.report = storage_file_alloc(frames.storage);
+    if(storage_file_open(frames.report, BARCODE_FRAMES_REPORT, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        storage_file_write(frames.report, "{\"frames\":[\n", 12);
+
+        for(int i = 0; i < UNKNOWN; i++) {
+            const BarcodeTypeObj* type_obj = &barcode_type_objs[i];
+
+            debug_view_create(app, type_obj);
+            debug_frames_measure(
+                &frames, "create", type_obj->name, debug_view_create_draw, false);
+
+            debug_view_save(app, frames.canvas);
+            debug_frames_measure(
+                &frames, "message", type_obj->name, debug_view_message_draw, false);
+
+            debug_view_load(app, frames.canvas);
+            for(size_t j = 0; j < COUNT_OF(renderers); j++) {
+                debug_frames_set_renderer(app, renderers[j].renderer);
+                debug_frames_measure(
+                    &frames, renderers[j].name, type_obj->name, debug_view_barcode_draw, true);
+            }
+            count += 2 + COUNT_OF(renderers);
+        }
+
+        storage_file_write(frames.report, "\n]}\n", 4);
+        debug_frames_set_renderer(app, BARCODE_DEFAULT_RENDERER);
+    } else {
+        BARCODE_LOG_E("Could not write %s", BARCODE_FRAMES_REPORT);
+    }
+    storage_file_close(frames.report);
+    storage_file_free(frames.report);
+    furi_record_close(RECORD_STORAGE);
+
+    gui_direct_draw_release(gui);
+    furi_record_close(RECORD_GUI);
+
+    debug_view_remove_file();
+    free(frames.pbm);
+    free(frames.golden);
+
+    BARCODE_LOG_I(
+        "Frames done, %d frames, %d differ from the golden frames",
+        (int)count,
+        (int)frames.golden_differs);
+    return count;
+}
+
+/**
+ * A golden barcode of barcode_goldens.h
+*/
+typedef struct {
+    const char* type;
+    const char* data;
+    const char* name; //the name of the PBM image in BARCODE_GOLDEN_FOLDER
+} DebugGolden;
+
+static const DebugGolden debug_goldens[] = {
+#define DEBUG_GOLDEN(type, data, name) {type, data, name},
+    BARCODE_GOLDENS(DEBUG_GOLDEN)
+#undef DEBUG_GOLDEN
+};
+
+/**
+ * Reads the golden PBM image of a barcode, the same binary PBM format as the frames
+ * @param pbm  DEBUG_PBM_SIZE bytes and one more, so a longer file is noticed
+ * @returns false if the image could not be read or is not a PBM image of the screen
+*/
+static bool debug_golden_read(Storage* storage, const DebugGolden* golden, uint8_t* pbm) {
+    FuriString* path = furi_string_alloc_printf("%s/%s.pbm", BARCODE_GOLDEN_FOLDER, golden->name);
+    File* file = storage_file_alloc(storage);
+    size_t size = 0;
+    if(storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        size = storage_file_read(file, pbm, DEBUG_PBM_SIZE + 1);
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+
+    bool read = size == DEBUG_PBM_SIZE &&
+                memcmp(pbm, DEBUG_PBM_HEADER, sizeof(DEBUG_PBM_HEADER) - 1) == 0;
+    if(!read) {
+        BARCODE_LOG_E("Could not read the golden image %s", furi_string_get_cstr(path));
+    }
+    furi_string_free(path);
+    return read;
+}
+
+/**
+ * Reads a row of the canvas as an xbm bitmap
+*/
+static void debug_canvas_row(Canvas* canvas, int y, uint8_t* row) {
+    const uint8_t* buffer = canvas_get_buffer(canvas);
+    memset(row, 0, BARCODE_ROW_BYTES);
+    for(int x = 0; x < 128; x++) {
+        if(buffer[(y >> 3) * 128 + x] & (1 << (y & 7))) {
+            row[x >> 3] |= 1 << (x & 7);
+        }
+    }
+}
+
+/**
+ * Checks the frame of a golden barcode on the canvas against its golden image
+ * Every row of the bars has to be the golden image bit for bit, the guard bars of the image have to extend
+ * below the bars, the text is not checked since it depends on the fonts of the firmware
+ * @param pbm  the golden image and DEBUG_PBM_SIZE bytes for the frame
+ * @returns true if the bars are the same as the golden image
+*/
+static bool debug_golden_check_bars(Canvas* canvas, const DebugGolden* golden, uint8_t* pbm) {
+    const uint8_t* expected = pbm + sizeof(DEBUG_PBM_HEADER) - 1;
+    uint8_t* frame = pbm + DEBUG_PBM_SIZE + 1;
+    debug_frames_pbm(canvas, frame);
+    frame += sizeof(DEBUG_PBM_HEADER) - 1;
+
+    for(int y = BARCODE_Y_START; y < BARCODE_Y_START + BARCODE_GUARD_HEIGHT; y++) {
+        for(int i = y * BARCODE_ROW_BYTES; i < (y + 1) * BARCODE_ROW_BYTES; i++) {
+            bool match = y < BARCODE_Y_START + BARCODE_HEIGHT ? frame[i] == expected[i] :
+                                                               (frame[i] & expected[i]) == expected[i];
+            if(!match) {
+                BARCODE_LOG_E(
+                    "golden %s %s: row %d differs at x %d",
+                    golden->type,
+                    golden->data,
+                    y,
+                    (i % BARCODE_ROW_BYTES) * 8);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Draws every golden barcode with every renderer and checks the bars of the frames and their budgets
+ * A faster renderer has to draw the same bars as the golden rows within BARCODE_GOLDEN_MAX_CALLS canvas
+ * calls and BARCODE_GOLDEN_MAX_FRAME_NS
+ * @returns the number of frames that failed
+*/
+size_t barcode_debug_golden(BarcodeApp* app) {
+    static const BarcodeRenderer renderers[] = {BarcodeRendererBoxes, BarcodeRendererRowBitmap};
+
+    DebugClock clock = {.last_cycles = DWT->CYCCNT, .cycles = 0};
+    FuriString* file_path = furi_string_alloc_set("golden");
+    FuriString* type = furi_string_alloc();
+    FuriString* data = furi_string_alloc();
+
+    //the golden image, one more byte to notice a longer file, and the frame
+    uint8_t* pbm = malloc(2 * DEBUG_PBM_SIZE + 1);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Gui* gui = furi_record_open(RECORD_GUI);
+    Canvas* canvas = gui_direct_draw_acquire(gui);
+
+    size_t failed = 0;
+    for(size_t i = 0; i < COUNT_OF(debug_goldens); i++) {
+        const DebugGolden* golden = &debug_goldens[i];
+        if(!debug_golden_read(storage, golden, pbm)) {
+            failed += COUNT_OF(renderers);
+            continue;
+        }
+        furi_string_set_str(type, golden->type);
+        furi_string_set_str(data, golden->data);
+
+        for(size_t j = 0; j < COUNT_OF(renderers); j++) {
+            set_barcode_data(app->barcode_view, file_path, type, data, OKCode);
+            debug_frames_set_renderer(app, renderers[j]);
+
+            //the first draw builds the render
+            debug_view_barcode_draw(app, canvas);
+
+            memset(canvas_calls, 0, sizeof(canvas_calls));
+            uint64_t start = debug_clock_ns(&clock);
+            for(int k = 0; k < BARCODE_FRAMES_REPEAT; k++) {
+                debug_view_barcode_draw(app, canvas);
+            }
+            uint64_t ns_per_frame = (debug_clock_ns(&clock) - start) / BARCODE_FRAMES_REPEAT;
+
+            uint32_t calls = 0;
+            for(int k = 0; k < BarcodeDebugCanvasCallCount; k++) {
+                calls += canvas_calls[k];
+            }
+            calls /= BARCODE_FRAMES_REPEAT;
+
+            bool ok = debug_golden_check_bars(canvas, golden, pbm);
+            if(calls > BARCODE_GOLDEN_MAX_CALLS) {
+                BARCODE_LOG_E(
+                    "golden %s %s: %lu calls, the budget is %d",
+                    golden->type,
+                    golden->data,
+                    (unsigned long)calls,
+                    BARCODE_GOLDEN_MAX_CALLS);
+                ok = false;
+            }
+            if(ns_per_frame > BARCODE_GOLDEN_MAX_FRAME_NS) {
+                BARCODE_LOG_E(
+                    "golden %s %s: %llu ns per frame, the budget is %d",
+                    golden->type,
+                    golden->data,
+                    (unsigned long long)ns_per_frame,
+                    BARCODE_GOLDEN_MAX_FRAME_NS);
+                ok = false;
+            }
+            failed += !ok;
+        }
+    }
+
+    debug_frames_set_renderer(app, BARCODE_DEFAULT_RENDERER);
+
+    gui_direct_draw_release(gui);
+    furi_record_close(RECORD_GUI);
+    furi_record_close(RECORD_STORAGE);
+
+    free(pbm);
+    furi_string_free(file_path);
+    furi_string_free(type);
+    furi_string_free(data);
+
+    BARCODE_LOG_I(
+        "Golden done, %d of %d frames failed",
+        (int)failed,
+        (int)(COUNT_OF(debug_goldens) * COUNT_OF(renderers)));
+    return failed;
+}
+
+static uint32_t debug_random(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/**
+ * Fills the data with random characters that are valid for the type
+ * @returns the length of the data
+*/
+static size_t debug_roundtrip_payload(const BarcodeTypeObj* type_obj, uint32_t* state, char* data) {
+    size_t length;
+    if(type_obj->max_digits > 0) {
+        //with and without the check digit
+        length = type_obj->max_digits - (debug_random(state) & 1);
+    } else {
+        length = type_obj->min_digits +
+                 debug_random(state) % (BARCODE_ROUNDTRIP_MAX_LENGTH - type_obj->min_digits + 1);
+    }
+
+    for(size_t i = 0; i < length; i++) {
+        if(type_obj->elements != NULL) {
+            //any character of the table but the delimiter, in upper or lower case
+            int character;
+            do {
+                character = debug_random(state) % 128;
+            } while(type_obj->elements[character] == NULL || character == type_obj->delimiter);
+            data[i] = debug_random(state) & 1 ? tolower(character) : character;
+        } else if(type_obj->type == CODE128) {
+            //every ascii character but the null terminator
+            data[i] = 1 + debug_random(state) % 127;
+        } else {
+            data[i] = '0' + debug_random(state) % 10;
+        }
+    }
+    data[length] = '\0';
+    return length;
+}
+
+/**
+ * Loads random barcodes of every type into the barcode view and decodes them again
+ * The modules from barcode_loader are decoded, and so is a row of the frame drawn by the renderer when
+ * the whole barcode fits on the screen, both have to be the text a scanner would read
+ * The results of every type are written to the round trip report
+ * @returns the number of barcodes that did not round trip
+*/
+size_t barcode_debug_roundtrip(BarcodeApp* app) {
+    DebugClock clock = {.last_cycles = DWT->CYCCNT, .cycles = 0};
+    uint32_t state = BARCODE_ROUNDTRIP_SEED;
+
+    char* data = malloc(BARCODE_ROUNDTRIP_MAX_LENGTH + 1);
+    char* expected = malloc(BARCODE_ROUNDTRIP_MAX_LENGTH + 3);
+    char* text = malloc(BARCODE_ROUNDTRIP_MAX_LENGTH + 3);
+    ModuleBuffer* row_modules = module_buffer_alloc(128);
+    uint8_t row[BARCODE_ROW_BYTES];
+
+    FuriString* file_path = furi_string_alloc_set("roundtrip");
+    FuriString* type = furi_string_alloc();
+    FuriString* raw_data = furi_string_alloc();
+
+    Gui* gui = furi_record_open(RECORD_GUI);
+    Canvas* canvas = gui_direct_draw_acquire(gui);
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* report = storage_file_alloc(storage);
+    if(!storage_file_open(report, BARCODE_ROUNDTRIP_REPORT, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        BARCODE_LOG_E("Could not write %s", BARCODE_ROUNDTRIP_REPORT);
+    }
+    storage_file_write(report, "{\"results\":[\n", 13);
+
+    size_t mismatches = 0;
+    for(int i = 0; i < UNKNOWN; i++) {
+        const BarcodeTypeObj* type_obj = &barcode_type_objs[i];
+        furi_string_set_str(type, type_obj->name);
+
+        size_t type_mismatches = 0;
+        size_t rows = 0;
+        uint64_t start = debug_clock_ns(&clock);
+
+        for(int j = 0; j < BARCODE_ROUNDTRIP_COUNT; j++) {
+            size_t length = debug_roundtrip_payload(type_obj, &state, data);
+            barcode_decode_expected(
+                type_obj->type, data, length, expected, BARCODE_ROUNDTRIP_MAX_LENGTH + 3);
+
+            furi_string_set_str(raw_data, data);
+            set_barcode_data(app->barcode_view, file_path, type, raw_data, OKCode);
+
+            BarcodeDecodeResult result = BarcodeDecodeInvalidPattern;
+            bool fits = false;
+            with_view_model(
+                app->barcode_view->view,
+                BarcodeModel * model,
+                {
+                    if(model->data->valid) {
+                        result = barcode_decode(
+                            type_obj->type,
+                            model->data->modules,
+                            text,
+                            BARCODE_ROUNDTRIP_MAX_LENGTH + 3);
+                        fits = model->data->runs.total_width <= 128 - type_obj->start_pos;
+                    }
+                },
+                false);
+            bool ok = result == BarcodeDecodeOK && strcmp(text, expected) == 0;
+
+            //the renderer draws every module as a pixel, a row of the bars is the whole barcode
+            if(ok && fits) {
+                debug_view_barcode_draw(app, canvas);
+                debug_canvas_row(canvas, BARCODE_Y_START, row);
+                result = barcode_decode_row(
+                    type_obj->type,
+                    row,
+                    128,
+                    row_modules,
+                    text,
+                    BARCODE_ROUNDTRIP_MAX_LENGTH + 3);
+                ok = result == BarcodeDecodeOK && strcmp(text, expected) == 0;
+                rows++;
+            }
+
+            if(!ok) {
+                if(mismatches < BARCODE_ROUNDTRIP_MAX_LOGGED) {
+                    BARCODE_LOG_E(
+                        "roundtrip %s \"%s\": %s, decoded \"%s\", expected \"%s\"",
+                        type_obj->name,
+                        data,
+                        barcode_decode_result_name(result),
+                        text,
+                        expected);
+                }
+                mismatches++;
+                type_mismatches++;
+            }
+        }
+
+        uint64_t elapsed = debug_clock_ns(&clock) - start;
+        uint64_t per_second =
+            elapsed > 0 ? (uint64_t)BARCODE_ROUNDTRIP_COUNT * 1000000000ull / elapsed : 0;
+
+        char line[160];
+        int length = snprintf(
+            line,
+            sizeof(line),
+            "{\"type\":\"%s\",\"barcodes\":%d,\"rows\":%d,\"mismatches\":%d,\"barcodes_per_s\":%llu}%s\n",
+            type_obj->name,
+            BARCODE_ROUNDTRIP_COUNT,
+            (int)rows,
+            (int)type_mismatches,
+            (unsigned long long)per_second,
+            i + 1 < UNKNOWN ? "," : "");
+        if(length > 0) {
+            storage_file_write(report, line, MIN((size_t)length, sizeof(line) - 1));
+        }
+        BARCODE_LOG_I(
+            "roundtrip %s: %d barcodes, %d rows, %d mismatches, %llu barcodes/s",
+            type_obj->name,
+            BARCODE_ROUNDTRIP_COUNT,
+            (int)rows,
+            (int)type_mismatches,
+            (unsigned long long)per_second);
+    }
+
+    storage_file_write(report, "]}\n", 3);
+    storage_file_close(report);
+    storage_file_free(report);
+    furi_record_close(RECORD_STORAGE);
+
+    gui_direct_draw_release(gui);
+    furi_record_close(RECORD_GUI);
+
+    furi_string_free(file_path);
+    furi_string_free(type);
+    furi_string_free(raw_data);
+    module_buffer_free(row_modules);
+    free(data);
+    free(expected);
+    free(text);
+
+    BARCODE_LOG_I("Roundtrip done, %d mismatches", (int)mismatches);
+    return mismatches;
+}
+
+/**
+ * The state of a fuzz run, every load that is over a ceiling is a finding
+*/
+typedef struct {
+    DebugClock clock;
+    uint32_t state;
+    File* report;
+    size_t findings;
+} DebugFuzz;
+
+/**
+ * Replaces the characters that can't be written in the JSON report or the log
+*/
+static void debug_fuzz_printable(char* text) {
+    for(; *text != '\0'; text++) {
+        if(*text < ' ' || *text > '~' || *text == '"' || *text == '\\') {
+            *text = '?';
+        }
+    }
+}
+
+/**
+ * Fills the data with random characters, digits, printable characters or any byte but the null terminator
+ * @returns the length of the data
+*/
+static size_t debug_fuzz_payload(uint32_t* state, char* data) {
+    size_t length = debug_random(state) % (BARCODE_FUZZ_MAX_LENGTH + 1);
+    uint32_t kind = debug_random(state) % 3;
+    for(size_t i = 0; i < length; i++) {
+        if(kind == 0) {
+            data[i] = '0' + debug_random(state) % 10;
+        } else if(kind == 1) {
+            data[i] = ' ' + debug_random(state) % 95;
+        } else {
+            data[i] = 1 + debug_random(state) % 255;
+        }
+    }
+    data[length] = '\0';
+    return length;
+}
+
+/**
+ * Picks the name of a random type, a quarter of the names have a character changed or are cut short
+*/
+static void debug_fuzz_type(uint32_t* state, FuriString* type) {
+    furi_string_set_str(type, barcode_type_objs[debug_random(state) % (UNKNOWN + 1)].name);
+    if(debug_random(state) % 4 != 0 || furi_string_size(type) == 0) {
+        return;
+    }
+
+    size_t index = debug_random(state) % furi_string_size(type);
+    if(debug_random(state) & 1) {
+        furi_string_left(type, index);
+    } else {
+        furi_string_set_char(type, index, 1 + debug_random(state) % 255);
+    }
+}
+
+//the names of every type of BARCODE_TYPES, each after a ", "
+#define DEBUG_TYPE_NAME(type, name, ...) ", " name
+static const char debug_type_names[] = BARCODE_TYPES(DEBUG_TYPE_NAME);
+#undef DEBUG_TYPE_NAME
+
+/**
+ * Writes a barcode file the way save_barcode does, then changes, adds and removes random characters
+ * Some files get their data repeated until they are larger than BARCODE_MAX_FILE_SIZE
+*/
+static void debug_fuzz_file(uint32_t* state, FuriString* type, char* data, FuriString* file) {
+    debug_fuzz_type(state, type);
+    debug_fuzz_payload(state, data);
+    furi_string_printf(
+        file,
+        "Filetype: Barcode\nVersion: %s\n# Types - %s\nType: %s\nData: %s\n",
+        FILE_VERSION,
+        debug_type_names + 2,
+        furi_string_get_cstr(type),
+        data);
+
+    uint32_t mutations = debug_random(state) % 5;
+    for(uint32_t i = 0; i < mutations && furi_string_size(file) > 0; i++) {
+        size_t index = debug_random(state) % furi_string_size(file);
+        char character = 1 + debug_random(state) % 255;
+        switch(debug_random(state) % 4) {
+        case 0:
+            furi_string_set_char(file, index, character);
+            break;
+        case 1: {
+            char text[2] = {character, '\0'};
+            furi_string_replace_at(file, index, 0, text);
+            break;
+        }
+        case 2:
+            furi_string_replace_at(file, index, 1, "");
+            break;
+        default:
+            while(furi_string_size(file) <= BARCODE_MAX_FILE_SIZE && data[0] != '\0') {
+                furi_string_cat_str(file, data);
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * @returns the most app bytes in use during the phases of the last load, above the bytes in use when
+ * the phase began, the phases have to be reset before the load since a rejected load skips phases
+ * Reading the file only allocates in the firmware, so the most used heap is taken for it
+*/
+static size_t debug_fuzz_peak_bytes(bool read_file) {
+    size_t peak = barcode_debug_memory(BarcodeDebugPhaseValidate).peak_bytes +
+                  barcode_debug_memory(BarcodeDebugPhaseEncode).peak_bytes;
+    if(read_file) {
+        peak += barcode_debug_memory(BarcodeDebugPhaseReadFile).heap_peak_bytes;
+    }
+    return peak;
+}
+
+/**
+ * Checks the time and bytes of a load against the ceilings, and reports it if they are over
+*/
+static void debug_fuzz_check(
+    DebugFuzz* fuzz,
+    const char* target,
+    FuriString* type,
+    size_t length,
+    uint64_t ns,
+    size_t peak_bytes,
+    uint64_t fixed_ns,
+    size_t fixed_bytes) {
+    size_t characters = MIN(length, (size_t)BARCODE_MAX_DATA_LENGTH);
+    uint64_t max_ns = fixed_ns + (uint64_t)characters * BARCODE_FUZZ_NS_PER_CHARACTER;
+    size_t max_bytes = fixed_bytes + characters * BARCODE_FUZZ_BYTES_PER_CHARACTER;
+    if(ns <= max_ns && peak_bytes <= max_bytes) {
+        return;
+    }
+
+    if(fuzz->findings < BARCODE_FUZZ_MAX_FINDINGS) {
+        char name[16];
+        snprintf(name, sizeof(name), "%s", furi_string_get_cstr(type));
+        debug_fuzz_printable(name);
+
+        char line[192];
+        int line_length = snprintf(
+            line,
+            sizeof(line),
+            "%s{\"target\":\"%s\",\"type\":\"%s\",\"length\":%lu,\"ns\":%llu,\"max_ns\":%llu,"
+            "\"peak_bytes\":%lu,\"max_bytes\":%lu}\n",
+            fuzz->findings > 0 ? "," : "",
+            target,
+            name,
+            (unsigned long)length,
+            (unsigned long long)ns,
+            (unsigned long long)max_ns,
+            (unsigned long)peak_bytes,
+            (unsigned long)max_bytes);
+        if(line_length > 0) {
+            storage_file_write(fuzz->report, line, MIN((size_t)line_length, sizeof(line) - 1));
+        }
+        BARCODE_LOG_E(
+            "fuzz %s %s, %lu characters: %llu ns of %llu, %lu bytes of %lu",
+            target,
+            name,
+            (unsigned long)length,
+            (unsigned long long)ns,
+            (unsigned long long)max_ns,
+            (unsigned long)peak_bytes,
+            (unsigned long)max_bytes);
+    }
+    fuzz->findings++;
+}
+
+/**
+ * Feeds random barcodes to set_barcode_data and mutated barcode files to load_barcode
+ * A load may not crash and has to stay under the time and memory ceilings, the barcodes that are too
+ * long or the files that are too large have to be rejected before they are encoded
+ * The loads that are over a ceiling are written to the fuzz report
+ * @returns the number of loads that were over a ceiling
+*/
+size_t barcode_debug_fuzz(BarcodeApp* app) {
+    DebugFuzz fuzz = {
+        .clock = {.last_cycles = DWT->CYCCNT, .cycles = 0},
+        .state = BARCODE_FUZZ_SEED,
+        .findings = 0,
+    };
+
+    char* data = malloc(BARCODE_FUZZ_MAX_LENGTH + 1);
+    FuriString* file_path = furi_string_alloc_set(BARCODE_DEBUG_FILE_PATH);
+    FuriString* type = furi_string_alloc();
+    FuriString* raw_data = furi_string_alloc();
+    FuriString* file_text = furi_string_alloc();
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    fuzz.report = storage_file_alloc(storage);
+    if(!storage_file_open(fuzz.report, BARCODE_FUZZ_REPORT, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        BARCODE_LOG_E("Could not write %s", BARCODE_FUZZ_REPORT);
+    }
+    storage_file_write(fuzz.report, "{\"findings\":[\n", 14);
+
+    uint64_t max_ns = 0;
+    size_t max_bytes = 0;
+    for(int i = 0; i < BARCODE_FUZZ_COUNT; i++) {
+        debug_fuzz_type(&fuzz.state, type);
+        size_t length = debug_fuzz_payload(&fuzz.state, data);
+        furi_string_set_str(raw_data, data);
+
+        barcode_debug_memory_reset();
+        uint64_t start = debug_clock_ns(&fuzz.clock);
+        set_barcode_data(app->barcode_view, file_path, type, raw_data, OKCode);
+        uint64_t ns = debug_clock_ns(&fuzz.clock) - start;
+        size_t peak_bytes = debug_fuzz_peak_bytes(false);
+
+        max_ns = MAX(max_ns, ns);
+        max_bytes = MAX(max_bytes, peak_bytes);
+        debug_fuzz_check(
+            &fuzz,
+            "loader",
+            type,
+            length,
+            ns,
+            peak_bytes,
+            BARCODE_FUZZ_FIXED_NS,
+            BARCODE_FUZZ_FIXED_BYTES);
+    }
+    size_t loader_findings = fuzz.findings;
+
+    uint64_t file_max_ns = 0;
+    size_t file_max_bytes = 0;
+    for(int i = 0; i < BARCODE_FUZZ_FILE_COUNT; i++) {
+        debug_fuzz_file(&fuzz.state, type, data, file_text);
+
+        File* file = storage_file_alloc(storage);
+        if(storage_file_open(file, BARCODE_DEBUG_FILE_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            storage_file_write(file, furi_string_get_cstr(file_text), furi_string_size(file_text));
+        }
+        storage_file_close(file);
+        storage_file_free(file);
+
+        barcode_debug_memory_reset();
+        uint64_t start = debug_clock_ns(&fuzz.clock);
+        load_barcode(app, file_path);
+        uint64_t ns = debug_clock_ns(&fuzz.clock) - start;
+        size_t peak_bytes = debug_fuzz_peak_bytes(true);
+
+        file_max_ns = MAX(file_max_ns, ns);
+        file_max_bytes = MAX(file_max_bytes, peak_bytes);
+        debug_fuzz_check(
+            &fuzz,
+            "file",
+            type,
+            furi_string_size(file_text),
+            ns,
+            peak_bytes,
+            BARCODE_FUZZ_FILE_FIXED_NS,
+            BARCODE_FUZZ_FILE_FIXED_BYTES);
+    }
+    storage_simply_remove(storage, BARCODE_DEBUG_FILE_PATH);
+
+    char line[256];
+    int length = snprintf(
+        line,
+        sizeof(line),
+        "],\n\"loader\":{\"inputs\":%d,\"findings\":%d,\"max_ns\":%llu,\"max_peak_bytes\":%lu},\n"
+        "\"file\":{\"inputs\":%d,\"findings\":%d,\"max_ns\":%llu,\"max_peak_bytes\":%lu}}\n",
+        BARCODE_FUZZ_COUNT,
+        (int)loader_findings,
+        (unsigned long long)max_ns,
+        (unsigned long)max_bytes,
+        BARCODE_FUZZ_FILE_COUNT,
+        (int)(fuzz.findings - loader_findings),
+        (unsigned long long)file_max_ns,
+        (unsigned long)file_max_bytes);
+    if(length > 0) {
+        storage_file_write(fuzz.report, line, MIN((size_t)length, sizeof(line) - 1));
+    }
+    storage_file_close(fuzz.report);
+    storage_file_free(fuzz.report);
+    furi_record_close(RECORD_STORAGE);
+
+    furi_string_free(file_path);
+    furi_string_free(type);
+    furi_string_free(raw_data);
+    furi_string_free(file_text);
+    free(data);
+
+    BARCODE_LOG_I(
+        "Fuzz done, %d of %d loads over a ceiling",
+        (int)fuzz.findings,
+        BARCODE_FUZZ_COUNT + BARCODE_FUZZ_FILE_COUNT);
+    return fuzz.findings;
+}
+
+struct BarcodeDebugReplay {
+    BarcodeApp* app;
+    FuriThread* thread;
+    Gui* gui;
+    FuriPubSub* input_events;
+    FuriSemaphore* frame; //released by the first frame after an input
+    volatile bool waiting; //true while an input waits for its frame
+    volatile uint32_t frame_cycles; //when the frame was drawn
+    volatile bool stopped; //true when the app closes before the trace is done
+    uint32_t sequence;
+};
+
+/**
+ * The latencies of the inputs of a flow, a flow is a part of the trace like "create" or "save"
+*/
+typedef struct {
+    const char* name;
+    size_t name_length;
+    uint32_t latencies_us[BARCODE_REPLAY_MAX_INPUTS];
+    size_t count;
+    size_t missed; //the inputs that were not followed by a frame
+} DebugReplayFlow;
+
+static void debug_replay_frame(
+    uint8_t* data,
+    size_t size,
+    CanvasOrientation orientation,
+    void* context) {
+    UNUSED(data);
+    UNUSED(size);
+    UNUSED(orientation);
+    BarcodeDebugReplay* replay = context;
+    if(replay->waiting) {
+        replay->frame_cycles = DWT->CYCCNT;
+        replay->waiting = false;
+        furi_semaphore_release(replay->frame);
+    }
+}
+
+static int debug_replay_compare(const void* a, const void* b) {
+    uint32_t left = *(const uint32_t*)a;
+    uint32_t right = *(const uint32_t*)b;
+    return (left > right) - (left < right);
+}
+
+/**
+ * @returns the nearest rank percentile of the sorted latencies
+*/
+static uint32_t debug_replay_percentile(const DebugReplayFlow* flow, size_t percent) {
+    size_t rank = (flow->count * percent + 99) / 100;
+    return flow->latencies_us[rank > 0 ? rank - 1 : 0];
+}
+
+/**
+ * Sorts the latencies of the flow and writes its percentiles to the report
+*/
+static void debug_replay_report(DebugReplayFlow* flow, File* report, bool first) {
+    if(flow->count == 0 && flow->missed == 0) {
+        return;
+    }
+    qsort(flow->latencies_us, flow->count, sizeof(uint32_t), debug_replay_compare);
+
+    uint32_t p50 = 0, p90 = 0, p99 = 0, max = 0;
+    if(flow->count > 0) {
+        p50 = debug_replay_percentile(flow, 50);
+        p90 = debug_replay_percentile(flow, 90);
+        p99 = debug_replay_percentile(flow, 99);
+        max = flow->latencies_us[flow->count - 1];
+    }
+
+    char line[192];
+    int length = snprintf(
+        line,
+        sizeof(line),
+        "%s{\"flow\":\"%.*s\",\"inputs\":%lu,\"missed\":%lu,\"p50_us\":%lu,\"p90_us\":%lu,"
+        "\"p99_us\":%lu,\"max_us\":%lu}",
+        first ? "" : ",\n",
+        (int)flow->name_length,
+        flow->name,
+        (unsigned long)flow->count,
+        (unsigned long)flow->missed,
+        (unsigned long)p50,
+        (unsigned long)p90,
+        (unsigned long)p99,
+        (unsigned long)max);
+    if(length > 0) {
+        storage_file_write(report, line, MIN((size_t)length, sizeof(line) - 1));
+    }
+
+    BARCODE_LOG_I(
+        "replay %.*s: %d inputs, %d missed, p50 %lu us, p90 %lu us, p99 %lu us, max %lu us",
+        (int)flow->name_length,
+        flow->name,
+        (int)flow->count,
+        (int)flow->missed,
+        (unsigned long)p50,
+        (unsigned long)p90,
+        (unsigned long)p99,
+        (unsigned long)max);
+}
+
+/**
+ * Sends the events of one key action to the input service and waits for the frame that follows
+*/
+static void debug_replay_input(
+    BarcodeDebugReplay* replay,
+    DebugReplayFlow* flow,
+    InputKey key,
+    const InputType* types,
+    size_t type_count) {
+    furi_semaphore_acquire(replay->frame, 0);
+    replay->waiting = true;
+    uint32_t start = DWT->CYCCNT;
+
+    for(size_t i = 0; i < type_count; i++) {
+        InputEvent event = {.sequence = replay->sequence, .key = key, .type = types[i]};
+        furi_pubsub_publish(replay->input_events, &event);
+    }
+    replay->sequence++;
+
+    if(furi_semaphore_acquire(replay->frame, BARCODE_REPLAY_FRAME_TIMEOUT_MS) == FuriStatusOk) {
+        if(flow->count < BARCODE_REPLAY_MAX_INPUTS) {
+            flow->latencies_us[flow->count++] = (uint32_t)(replay->frame_cycles - start) /
+                                                furi_hal_cortex_instructions_per_microsecond();
+        }
+    } else {
+        replay->waiting = false;
+        flow->missed++;
+    }
+    furi_delay_ms(BARCODE_REPLAY_SETTLE_MS);
+}
+
+/**
+ * @returns true if the word matches the name
+*/
+static bool debug_word_is(const char* word, size_t length, const char* name) {
+    return strlen(name) == length && memcmp(word, name, length) == 0;
+}
+
+/**
+ * Finds the next word of a line, words are separated by spaces and tabs
+ * @returns the length of the word, 0 if the line has no more words
+*/
+static size_t debug_next_word(const char** cursor, const char* end, const char** word) {
+    const char* start = *cursor;
+    while(start < end && (*start == ' ' || *start == '\t')) {
+        start++;
+    }
+    const char* stop = start;
+    while(stop < end && *stop != ' ' && *stop != '\t') {
+        stop++;
+    }
+    *cursor = stop;
+    *word = start;
+    return stop - start;
+}
+
+static const struct {
+    const char* name;
+    InputKey key;
+} debug_replay_keys[] = {
+    {"up", InputKeyUp},
+    {"down", InputKeyDown},
+    {"left", InputKeyLeft},
+    {"right", InputKeyRight},
+    {"ok", InputKeyOk},
+    {"back", InputKeyBack},
+};
+
+static const InputType debug_replay_short[] = {InputTypePress, InputTypeShort, InputTypeRelease};
+static const InputType debug_replay_long[] = {InputTypePress, InputTypeLong, InputTypeRelease};
+static const InputType debug_replay_press[] = {InputTypePress};
+static const InputType debug_replay_release[] = {InputTypeRelease};
+
+/**
+ * Replays the trace, one line at a time
+ * "short <key> [count]" and "long <key> [count]" press and release a key, "press <key>" and
+ * "release <key>" send a single event, "wait <ms>" pauses and "flow <name>" starts a new flow
+ * Everything after a # is a comment
+*/
+static int32_t debug_replay_thread(void* context) {
+    BarcodeDebugReplay* replay = context;
+    furi_delay_ms(BARCODE_REPLAY_START_MS);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    char* trace = debug_read_file(storage, BARCODE_REPLAY_TRACE);
+    if(trace == NULL) {
+        BARCODE_LOG_E("Could not read %s", BARCODE_REPLAY_TRACE);
+        furi_record_close(RECORD_STORAGE);
+        return 0;
+    }
+
+    File* report = storage_file_alloc(storage);
+    if(!storage_file_open(report, BARCODE_REPLAY_REPORT, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        BARCODE_LOG_E("Could not write %s", BARCODE_REPLAY_REPORT);
+    }
+    storage_file_write(report, "{\"flows\":[\n", 11);
+
+    DebugReplayFlow* flow = malloc(sizeof(DebugReplayFlow));
+    flow->name = "trace";
+    flow->name_length = 5;
+    flow->count = 0;
+    flow->missed = 0;
+    bool first = true;
+
+    for(const char* line = trace; line != NULL && *line != '\0' && !replay->stopped;) {
+        const char* next = strchr(line, '\n');
+        const char* end = next == NULL ? line + strlen(line) : next;
+        const char* comment = memchr(line, '#', end - line);
+        if(comment != NULL) {
+            end = comment;
+        }
+        while(end > line && (end[-1] == '\r' || end[-1] == ' ')) {
+            end--;
+        }
+
+        const char* cursor = line;
+        const char* command;
+        const char* argument;
+        const char* count_word;
+        size_t command_length = debug_next_word(&cursor, end, &command);
+        size_t argument_length = debug_next_word(&cursor, end, &argument);
+        size_t count_length = debug_next_word(&cursor, end, &count_word);
+        uint32_t count = count_length > 0 ? strtoul(count_word, NULL, 10) : 1;
+
+        if(debug_word_is(command, command_length, "flow")) {
+            debug_replay_report(flow, report, first);
+            first &= flow->count == 0 && flow->missed == 0;
+            flow->name = argument;
+            flow->name_length = argument_length;
+            flow->count = 0;
+            flow->missed = 0;
+        } else if(debug_word_is(command, command_length, "wait")) {
+            furi_delay_ms(strtoul(argument, NULL, 10));
+        } else if(command_length > 0) {
+            const InputType* types = NULL;
+            size_t type_count = 0;
+            if(debug_word_is(command, command_length, "short")) {
+                types = debug_replay_short;
+                type_count = COUNT_OF(debug_replay_short);
+            } else if(debug_word_is(command, command_length, "long")) {
+                types = debug_replay_long;
+                type_count = COUNT_OF(debug_replay_long);
+            } else if(debug_word_is(command, command_length, "press")) {
+                types = debug_replay_press;
+                type_count = COUNT_OF(debug_replay_press);
+            } else if(debug_word_is(command, command_length, "release")) {
+                types = debug_replay_release;
+                type_count = COUNT_OF(debug_replay_release);
+            }
+
+            size_t key = 0;
+            while(key < COUNT_OF(debug_replay_keys) &&
+                  !debug_word_is(argument, argument_length, debug_replay_keys[key].name)) {
+                key++;
+            }
+
+            if(types == NULL || key == COUNT_OF(debug_replay_keys)) {
+                BARCODE_LOG_E("Unknown trace line: %.*s", (int)(end - line), line);
+            } else {
+                for(uint32_t i = 0; i < count && !replay->stopped; i++) {
+                    debug_replay_input(
+                        replay, flow, debug_replay_keys[key].key, types, type_count);
+                }
+            }
+        }
+
+        line = next == NULL ? NULL : next + 1;
+    }
+
+    debug_replay_report(flow, report, first);
+    storage_file_write(report, "\n]}\n", 4);
+    storage_file_close(report);
+    storage_file_free(report);
+    furi_record_close(RECORD_STORAGE);
+
+    //the flow names point into the trace
+    free(flow);
+    free(trace);
+
+    BARCODE_LOG_I("Replay done");
+    if(!replay->stopped) {
+        view_dispatcher_stop(replay->app->view_dispatcher);
+    }
+    return 0;
+}
+
+/**
+ * Starts replaying BARCODE_REPLAY_TRACE into the app on its own thread, the app has to be run after this
+ * Every input is sent to the input service like a real key press, so it goes through the GUI, the view
+ * dispatcher and the input callbacks of the views, and its latency is the time until the next frame
+ * The app is closed when the trace is done
+*/
+BarcodeDebugReplay* barcode_debug_replay_start(BarcodeApp* app) {
+    BarcodeDebugReplay* replay = malloc(sizeof(BarcodeDebugReplay));
+    replay->app = app;
+    replay->waiting = false;
+    replay->stopped = false;
+    replay->sequence = 0;
+    replay->frame = furi_semaphore_alloc(1, 0);
+    replay->input_events = furi_record_open(RECORD_INPUT_EVENTS);
+    replay->gui = furi_record_open(RECORD_GUI);
+    gui_add_framebuffer_callback(replay->gui, debug_replay_frame, replay);
+
+    replay->thread =
+        furi_thread_alloc_ex("BarcodeReplay", 2 * 1024, debug_replay_thread, replay);
+    furi_thread_start(replay->thread);
+    return replay;
+}
+
+/**
+ * Waits for the replay to end, it ends early if the app was closed before the trace was done
+*/
+void barcode_debug_replay_free(BarcodeDebugReplay* replay) {
+    replay->stopped = true;
+    furi_thread_join(replay->thread);
+    furi_thread_free(replay->thread);
+
+    gui_remove_framebuffer_callback(replay->gui, debug_replay_frame, replay);
+    furi_record_close(RECORD_GUI);
+    furi_record_close(RECORD_INPUT_EVENTS);
+    furi_semaphore_free(replay->frame);
+    free(replay);
+}
+
+static const char* const memory_phase_names[BarcodeDebugPhaseCount] = {
+    [BarcodeDebugPhaseReadFile] = "read file",
+    [BarcodeDebugPhaseValidate] = "validate",
+    [BarcodeDebugPhaseEncode] = "encode",
+    [BarcodeDebugPhaseFirstDraw] = "first draw",
+};
+
+//the memory use of every phase, and the counters when the phase began
+//the phases run on the load thread and the GUI thread, the counters are only used in a critical section
+static BarcodeDebugMemory memory_phases[BarcodeDebugPhaseCount];
+static BarcodeAllocStats memory_phase_start[BarcodeDebugPhaseCount];
+static size_t memory_phase_start_heap[BarcodeDebugPhaseCount];
+static size_t memory_phase_min_heap[BarcodeDebugPhaseCount]; //the least free heap seen during the phase
+static int32_t memory_phase_start_strings[BarcodeDebugPhaseCount];
+
+static int32_t string_count;
+
+/**
+ * Starts measuring the memory used by a phase
+ * Phases can't be nested with themselves, the peak is shared so a nested phase, or a phase on the other
+ * thread, resets the outer peak
+*/
+void barcode_debug_memory_begin(BarcodeDebugPhase phase) {
+    size_t free_heap = memmgr_get_free_heap();
+
+    FURI_CRITICAL_ENTER();
+    barcode_alloc_reset_peak();
+    barcode_alloc_get_stats(&memory_phase_start[phase]);
+    memory_phase_start_heap[phase] = free_heap;
+    memory_phase_min_heap[phase] = free_heap;
+    memory_phase_start_strings[phase] = string_count;
+    FURI_CRITICAL_EXIT();
+}
+
+/**
+ * Stops measuring the memory used by a phase, the peak is written to the timing trace as an event
+ * The whole measurement is only logged with BARCODE_LOG_LEVEL_VERBOSE, it would be a log line for every
+ * phase of every load
+*/
+void barcode_debug_memory_end(BarcodeDebugPhase phase) {
+    size_t free_heap = memmgr_get_free_heap();
+    BarcodeDebugMemory memory;
+
+    FURI_CRITICAL_ENTER();
+    BarcodeAllocStats stats;
+    barcode_alloc_get_stats(&stats);
+    const BarcodeAllocStats* start = &memory_phase_start[phase];
+
+    memory.allocs = stats.allocs - start->allocs;
+    memory.frees = stats.frees - start->frees;
+    memory.bytes = (int32_t)(stats.bytes_in_use - start->bytes_in_use);
+    memory.peak_bytes = stats.peak_bytes - start->bytes_in_use;
+    memory.strings = string_count - memory_phase_start_strings[phase];
+    memory.heap_bytes = (int32_t)(memory_phase_start_heap[phase] - free_heap);
+    memory.heap_peak_bytes = memory_phase_start_heap[phase] - MIN(memory_phase_min_heap[phase], free_heap);
+    memory_phases[phase] = memory;
+    FURI_CRITICAL_EXIT();
+
+    //reading the file makes no app allocations, its peak is the one of the heap
+    barcode_trace_event(
+        BarcodeTraceMemory,
+        phase,
+        phase == BarcodeDebugPhaseReadFile ? memory.heap_peak_bytes : memory.peak_bytes);
+    BARCODE_LOG_V(
+        "memory %s: %lu allocs, %lu frees, %ld bytes, %lu peak, %ld strings, %ld heap, %lu heap peak",
+        memory_phase_names[phase],
+        (unsigned long)memory.allocs,
+        (unsigned long)memory.frees,
+        (long)memory.bytes,
+        (unsigned long)memory.peak_bytes,
+        (long)memory.strings,
+        (long)memory.heap_bytes,
+        (unsigned long)memory.heap_peak_bytes);
+}
+
+/**
+ * Looks at the free heap during a phase, called where the phase holds the most memory that isn't
+ * allocated by the app, like the open FlipperFormat of a barcode file
+*/
+void barcode_debug_memory_sample(BarcodeDebugPhase phase) {
+    size_t free_heap = memmgr_get_free_heap();
+
+    FURI_CRITICAL_ENTER();
+    memory_phase_min_heap[phase] = MIN(memory_phase_min_heap[phase], free_heap);
+    FURI_CRITICAL_EXIT();
+}
+
+/**
+ * Forgets the memory used by every phase, a phase that doesn't run again reports nothing
+*/
+void barcode_debug_memory_reset() {
+    FURI_CRITICAL_ENTER();
+    memset(memory_phases, 0, sizeof(memory_phases));
+    FURI_CRITICAL_EXIT();
+}
+
+/**
+ * @returns the memory used by the phase the last time it ran, a copy so it can't change while it is read
+*/
+BarcodeDebugMemory barcode_debug_memory(BarcodeDebugPhase phase) {
+    FURI_CRITICAL_ENTER();
+    BarcodeDebugMemory memory = memory_phases[phase];
+    FURI_CRITICAL_EXIT();
+    return memory;
+}
+
+FuriString* barcode_debug_string_allocated(FuriString* string) {
+    FURI_CRITICAL_ENTER();
+    string_count++;
+    FURI_CRITICAL_EXIT();
+    return string;
+}
+
+void barcode_debug_string_freed() {
+    FURI_CRITICAL_ENTER();
+    string_count--;
+    FURI_CRITICAL_EXIT();
+}
+
+#endif
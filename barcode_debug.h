@@ -0,0 +1,216 @@
+#pragma once
+
+#include "barcode_app.h"
+
+#ifdef BARCODE_DEBUG
+
+#include "barcode_bench.h"
+#include "barcode_decoder.h"
+#include "barcode_goldens.h"
+
+//the app arguments that run the benchmark instead of opening the app: loader open "Barcode App" bench
+#define BARCODE_BENCH_ARGS "bench"
+
+//the benchmark report, copy it to the baseline to compare later runs with it
+#define BARCODE_BENCH_REPORT DEFAULT_USER_BARCODES "/bench.json"
+#define BARCODE_BENCH_BASELINE DEFAULT_USER_BARCODES "/bench_baseline.json"
+
+//how long every benchmark result is timed for
+#define BARCODE_BENCH_MIN_TIME_NS (20 * 1000 * 1000)
+
+size_t barcode_debug_bench();
+
+//the results of the Benchmark menu item, as CSV so they can be compared with a host build of the core
+#define BARCODE_BENCH_CSV DEFAULT_USER_BARCODES "/bench.csv"
+
+//the Benchmark menu item times every result for less time and sweeps shorter payloads than the bench app
+//arguments, so it finishes in a few seconds
+#define BARCODE_BENCH_MENU_MIN_TIME_NS (2 * 1000 * 1000)
+#define BARCODE_BENCH_MENU_MAX_LENGTH 64
+
+//the number of times the barcode of every type is loaded and drawn by the Benchmark menu item
+#define BARCODE_BENCH_MENU_REPEAT 16
+
+size_t barcode_debug_bench_menu(BarcodeApp* app);
+
+//the barcode file the longest barcodes of the stack and frame measurements are saved to and loaded from
+#define BARCODE_DEBUG_FILE_NAME ".debug"
+#define BARCODE_DEBUG_FILE_PATH DEFAULT_USER_BARCODES "/" BARCODE_DEBUG_FILE_NAME BARCODE_EXTENSION
+
+//the app arguments that measure the stack instead of opening the app: loader open "Barcode App" stack
+#define BARCODE_STACK_ARGS "stack"
+
+//the stack of the app thread, stack_size in application.fam
+#define BARCODE_APP_STACK_SIZE (2 * 1024)
+
+//the stack of the threads the steps are measured on, bigger than the app stack so a step that would
+//overflow the app stack is measured instead of crashing
+#define BARCODE_STACK_MEASURE_SIZE (4 * 1024)
+
+
+size_t barcode_debug_stack(BarcodeApp* app);
+
+//the app arguments that measure the frames of the views instead of opening the app: loader open "Barcode App" frames
+#define BARCODE_FRAMES_ARGS "frames"
+
+//the frame report, and the folder every measured frame is written to as a PBM image
+#define BARCODE_FRAMES_REPORT DEFAULT_USER_BARCODES "/frames.json"
+#define BARCODE_FRAMES_FOLDER DEFAULT_USER_BARCODES "/frames"
+
+//copy frames to the golden folder to compare the frames of later runs with them
+#define BARCODE_FRAMES_GOLDEN DEFAULT_USER_BARCODES "/golden"
+
+//how many times every frame is drawn after the first draw to time it
+#define BARCODE_FRAMES_REPEAT 32
+
+/**
+ * The canvas functions the barcode view calls through its barcode_canvas_ functions, every call is counted
+ * to measure what a frame costs
+*/
+typedef enum {
+    BarcodeDebugCanvasClear,
+    BarcodeDebugCanvasSetColor,
+    BarcodeDebugCanvasSetFont,
+    BarcodeDebugCanvasDrawBox,
+    BarcodeDebugCanvasDrawStr,
+    BarcodeDebugCanvasDrawXbm,
+    BarcodeDebugCanvasMultilineText,
+
+    BarcodeDebugCanvasCallCount
+} BarcodeDebugCanvasCall;
+
+void barcode_debug_canvas_call(BarcodeDebugCanvasCall call);
+
+size_t barcode_debug_frames(BarcodeApp* app);
+
+//the app arguments that check the frames of the golden barcodes instead of opening the app:
+//loader open "Barcode App" golden
+#define BARCODE_GOLDEN_ARGS "golden"
+
+//the folder the golden_bars folder of the repository is copied to
+#define BARCODE_GOLDEN_FOLDER DEFAULT_USER_BARCODES "/" BARCODE_GOLDEN_BARS
+
+//the most canvas calls and time a frame of a golden barcode may take after the first draw
+//the row bitmap renderer takes about 71 calls for EAN-13 and the boxes renderer about 64 for the longest
+//Codabar, the budget is a third above them so it only fails when a change makes a renderer slower
+#define BARCODE_GOLDEN_MAX_CALLS 96
+#define BARCODE_GOLDEN_MAX_FRAME_NS (2 * 1000 * 1000)
+
+size_t barcode_debug_golden(BarcodeApp* app);
+
+//the app arguments that round trip random barcodes through the loader, the renderer and the decoder
+//instead of opening the app: loader open "Barcode App" roundtrip
+#define BARCODE_ROUNDTRIP_ARGS "roundtrip"
+#define BARCODE_ROUNDTRIP_REPORT DEFAULT_USER_BARCODES "/roundtrip.json"
+
+//the number of random barcodes of every type, the longest data of the types without a fixed length
+//and the seed of the random data so a run can be repeated
+#define BARCODE_ROUNDTRIP_COUNT 1000
+#define BARCODE_ROUNDTRIP_MAX_LENGTH 32
+#define BARCODE_ROUNDTRIP_SEED 0x2545F491
+
+//the most mismatches that are logged
+#define BARCODE_ROUNDTRIP_MAX_LOGGED 16
+
+size_t barcode_debug_roundtrip(BarcodeApp* app);
+
+//the app arguments that feed random and mutated input to the loaders instead of opening the app:
+//loader open "Barcode App" fuzz
+#define BARCODE_FUZZ_ARGS "fuzz"
+#define BARCODE_FUZZ_REPORT DEFAULT_USER_BARCODES "/fuzz.json"
+
+//the number of random barcodes given to set_barcode_data, the number of mutated files given to
+//load_barcode and the seed of the input so a run can be repeated
+#define BARCODE_FUZZ_COUNT 2000
+#define BARCODE_FUZZ_FILE_COUNT 200
+#define BARCODE_FUZZ_SEED 0x9E3779B9
+
+//the longest random data, longer than BARCODE_MAX_DATA_LENGTH so the limit is fuzzed too
+#define BARCODE_FUZZ_MAX_LENGTH (BARCODE_MAX_DATA_LENGTH * 2)
+
+//the most time and app bytes a load may take, a fixed part and a part for every character of the data
+//data longer than BARCODE_MAX_DATA_LENGTH has to be rejected, so it gets the ceiling of the longest data
+//the time includes the log lines of the load, reading a file also gets the time of the SD card
+//reading a file is measured on the heap, so it also gets the FlipperFormat, the open file and its buffers
+#define BARCODE_FUZZ_FIXED_NS (20 * 1000 * 1000)
+#define BARCODE_FUZZ_FILE_FIXED_NS (200 * 1000 * 1000)
+#define BARCODE_FUZZ_NS_PER_CHARACTER (50 * 1000)
+#define BARCODE_FUZZ_FIXED_BYTES 256
+#define BARCODE_FUZZ_FILE_FIXED_BYTES 2048
+#define BARCODE_FUZZ_BYTES_PER_CHARACTER 64
+
+//the most findings that are logged and written to the report
+#define BARCODE_FUZZ_MAX_FINDINGS 32
+
+size_t barcode_debug_fuzz(BarcodeApp* app);
+
+//the app arguments that replay the input trace while the app runs: loader open "Barcode App" replay
+#define BARCODE_REPLAY_ARGS "replay"
+
+//the input trace that is replayed and the latency report
+#define BARCODE_REPLAY_TRACE DEFAULT_USER_BARCODES "/trace.txt"
+#define BARCODE_REPLAY_REPORT DEFAULT_USER_BARCODES "/replay.json"
+
+//how long the replay waits for the app to start before the first input
+#define BARCODE_REPLAY_START_MS 500
+
+//how long the replay waits for the frame of an input, inputs without a frame in time are counted as missed
+#define BARCODE_REPLAY_FRAME_TIMEOUT_MS 500
+
+//how long the replay waits after the frame of an input so the app is idle before the next input
+#define BARCODE_REPLAY_SETTLE_MS 50
+
+//the most inputs of a flow that the latency is kept for
+#define BARCODE_REPLAY_MAX_INPUTS 256
+
+typedef struct BarcodeDebugReplay BarcodeDebugReplay;
+
+BarcodeDebugReplay* barcode_debug_replay_start(BarcodeApp* app);
+void barcode_debug_replay_free(BarcodeDebugReplay* replay);
+
+/**
+ * The phases of loading and showing a barcode that the memory use is reported for
+*/
+typedef enum {
+    BarcodeDebugPhaseReadFile, //reading the type and data from the barcode file, the firmware allocates it
+    BarcodeDebugPhaseValidate, //allocating the barcode data and looking up the type
+    BarcodeDebugPhaseEncode, //encoding the barcode, building its text and runs
+    BarcodeDebugPhaseFirstDraw, //building the render on the first draw
+
+    BarcodeDebugPhaseCount
+} BarcodeDebugPhase;
+
+/**
+ * The memory used by a phase the last time it ran
+*/
+typedef struct {
+    uint32_t allocs; //the number of app allocations
+    uint32_t frees; //the number of app frees
+    int32_t bytes; //the change of the app bytes in use
+    uint32_t peak_bytes; //the most app bytes in use during the phase above the bytes in use when it began
+    int32_t strings; //the change of the number of FuriStrings of the barcodes
+    int32_t heap_bytes; //the change of the used heap, includes the allocations of the firmware and other threads
+    //the most used heap during the phase above the used heap when it began, the heap is only looked at when
+    //the phase begins and ends and at barcode_debug_memory_sample
+    uint32_t heap_peak_bytes;
+} BarcodeDebugMemory;
+
+void barcode_debug_memory_begin(BarcodeDebugPhase phase);
+void barcode_debug_memory_end(BarcodeDebugPhase phase);
+void barcode_debug_memory_sample(BarcodeDebugPhase phase);
+void barcode_debug_memory_reset();
+BarcodeDebugMemory barcode_debug_memory(BarcodeDebugPhase phase);
+
+//the FuriStrings of the barcodes are counted where they are allocated and freed
+FuriString* barcode_debug_string_allocated(FuriString* string);
+void barcode_debug_string_freed();
+
+#else
+
+#define barcode_debug_memory_begin(phase)
+#define barcode_debug_memory_end(phase)
+#define barcode_debug_memory_sample(phase)
+#define barcode_debug_string_allocated(string) (string)
+#define barcode_debug_string_freed()
+
+#endif
@@ -0,0 +1,394 @@
+#include "barcode_decoder.h"
+#include "barcode_encoder.h"
+#include "encodings.h"
+
+#include <ctype.h>
+#include <string.h>
+
+/**
+ * Reads the modules of a barcode from its first bar to its last bar, the quiet zones are skipped
+*/
+typedef struct {
+    const ModuleBuffer* modules;
+    size_t position; //the next module to read
+    size_t end; //one past the last bar
+} ModuleReader;
+
+/**
+ * Collects the decoded text, the text is always null terminated
+*/
+typedef struct {
+    char* text;
+    size_t size;
+    size_t length;
+    bool overflow; //true if a character didn't fit
+} TextWriter;
+
+static const char* const decode_result_names[] = {
+    [BarcodeDecodeOK] = "ok",
+    [BarcodeDecodeUnsupportedType] = "unsupported type",
+    [BarcodeDecodeInvalidPattern] = "invalid pattern",
+    [BarcodeDecodeWrongCheck] = "wrong check",
+    [BarcodeDecodeTextTooLong] = "text too long",
+};
+
+const char* barcode_decode_result_name(BarcodeDecodeResult result) {
+    return decode_result_names[result];
+}
+
+static void reader_init(ModuleReader* reader, const ModuleBuffer* modules) {
+    size_t length = module_buffer_size(modules);
+    size_t start = 0;
+    while(start < length && !module_buffer_get(modules, start)) {
+        start++;
+    }
+    size_t end = length;
+    while(end > start && !module_buffer_get(modules, end - 1)) {
+        end--;
+    }
+
+    reader->modules = modules;
+    reader->position = start;
+    reader->end = end;
+}
+
+static bool reader_has(const ModuleReader* reader, size_t count) {
+    return reader->end - reader->position >= count;
+}
+
+/**
+ * Reads modules msb first, the same way module_buffer_append_bits appends them
+*/
+static uint32_t reader_bits(ModuleReader* reader, uint8_t count) {
+    uint32_t bits = 0;
+    for(uint8_t i = 0; i < count; i++) {
+        bits = (bits << 1) | module_buffer_get(reader->modules, reader->position++);
+    }
+    return bits;
+}
+
+static void text_append(TextWriter* writer, char character) {
+    if(writer->length + 1 < writer->size) {
+        writer->text[writer->length++] = character;
+        writer->text[writer->length] = '\0';
+    } else {
+        writer->overflow = true;
+    }
+}
+
+static int find_code(const uint8_t* codes, uint8_t code) {
+    for(int digit = 0; digit < 10; digit++) {
+        if(codes[digit] == code) {
+            return digit;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Decodes an EAN-8, EAN-13, or UPC-A barcode, the text has every digit including the check digit
+ * The first digit of EAN-13 has no bars, it is decoded from the L/G parity of the left half
+*/
+static BarcodeDecodeResult
+    ean_upc_decode(const EanUpcLayout* layout, ModuleReader* reader, TextWriter* writer) {
+    char digits[16];
+    uint8_t parity = 0;
+
+    if(!reader_has(reader, 3) || reader_bits(reader, 3) != EAN_UPC_SIDE_GUARD) {
+        return BarcodeDecodeInvalidPattern;
+    }
+
+    for(size_t i = layout->first_digit; i < layout->digit_count; i++) {
+        size_t position = i - layout->first_digit;
+        if(!reader_has(reader, EAN_UPC_DIGIT_MODULES)) {
+            return BarcodeDecodeInvalidPattern;
+        }
+        uint8_t code = reader_bits(reader, EAN_UPC_DIGIT_MODULES);
+
+        int digit;
+        if(position < layout->left_digits) {
+            digit = find_code(UPC_EAN_L_CODES, code);
+            parity <<= 1;
+            if(digit < 0) {
+                digit = find_code(EAN_G_CODES, code);
+                parity |= 1;
+            }
+        } else {
+            digit = find_code(UPC_EAN_R_CODES, code);
+        }
+        if(digit < 0) {
+            return BarcodeDecodeInvalidPattern;
+        }
+        digits[i] = '0' + digit;
+
+        if(position == layout->left_digits - 1u &&
+           (!reader_has(reader, 5) || reader_bits(reader, 5) != EAN_UPC_CENTER_GUARD)) {
+            return BarcodeDecodeInvalidPattern;
+        }
+    }
+
+    if(!reader_has(reader, 3) || reader_bits(reader, 3) != EAN_UPC_SIDE_GUARD ||
+       reader->position != reader->end) {
+        return BarcodeDecodeInvalidPattern;
+    }
+
+    if(layout->parity != NULL) {
+        int first = find_code(layout->parity, parity);
+        if(first < 0) {
+            return BarcodeDecodeInvalidPattern;
+        }
+        digits[0] = '0' + first;
+    } else if(parity != 0) {
+        return BarcodeDecodeInvalidPattern;
+    }
+
+    for(size_t i = 0; i < layout->digit_count; i++) {
+        text_append(writer, digits[i]);
+    }
+
+    int check_digit = ean_upc_check_digit(digits, layout->digit_count - 1);
+    return digits[layout->digit_count - 1] - '0' == check_digit ? BarcodeDecodeOK :
+                                                                  BarcodeDecodeWrongCheck;
+}
+
+/**
+ * Reads a wide/narrow character and the narrow space after it, the last character has no space after it
+ * @returns true if the modules are the character
+*/
+static bool wide_narrow_read(ModuleReader* reader, const char* elements) {
+    size_t position = reader->position;
+    for(int i = 0; elements[i] != '\0'; i++) {
+        bool bar = (i & 1) == 0;
+        size_t width = elements[i] == '1' ? 3 : 1;
+        for(size_t j = 0; j < width; j++, position++) {
+            if(position >= reader->end || module_buffer_get(reader->modules, position) != bar) {
+                return false;
+            }
+        }
+    }
+
+    if(position < reader->end) {
+        if(module_buffer_get(reader->modules, position)) {
+            return false;
+        }
+        position++;
+    }
+    reader->position = position;
+    return true;
+}
+
+/**
+ * Decodes a Code 39 or Codabar barcode, the text has every character including the delimiters
+ * The characters are compared with every character of the encoding table, neither type has a check character
+*/
+static BarcodeDecodeResult
+    wide_narrow_decode(const BarcodeTypeObj* type_obj, ModuleReader* reader, TextWriter* writer) {
+    if(reader->position == reader->end) {
+        return BarcodeDecodeInvalidPattern;
+    }
+
+    while(reader->position < reader->end) {
+        int character = 0;
+        while(character < 128 && (type_obj->elements[character] == NULL ||
+                                  !wide_narrow_read(reader, type_obj->elements[character]))) {
+            character++;
+        }
+        if(character == 128) {
+            return BarcodeDecodeInvalidPattern;
+        }
+        text_append(writer, character);
+    }
+    return BarcodeDecodeOK;
+}
+
+/**
+ * @returns the value of a Code 128 codeword pattern or -1 if it isn't one
+*/
+static int code_128_codeword(uint32_t pattern) {
+    for(int value = 0; value < CODE_128_STOP; value++) {
+        if(CODE_128_PATTERNS[value] == pattern) {
+            return value;
+        }
+    }
+    return -1;
+}
+
+/**
+ * The state of a Code 128 decode, the code set and if the next codeword is shifted to the other set
+*/
+typedef struct {
+    char set; //'A', 'B' or 'C'
+    bool shift;
+} Code128State;
+
+/**
+ * Decodes a codeword that is neither the start, the check codeword or the stop
+ * @returns false if the codeword can't be in a barcode of this app (FNC codewords)
+*/
+static bool code_128_decode_codeword(Code128State* state, int value, TextWriter* writer) {
+    char set = state->set;
+    if(state->shift) {
+        set = set == 'A' ? 'B' : 'A';
+        state->shift = false;
+        if(value >= 96) {
+            return false;
+        }
+    }
+
+    if(set == 'C') {
+        if(value < 100) {
+            text_append(writer, '0' + value / 10);
+            text_append(writer, '0' + value % 10);
+        } else if(value == CODE_128_CODE_B || value == CODE_128_CODE_A) {
+            state->set = value == CODE_128_CODE_B ? 'B' : 'A';
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    if(value < 96) {
+        //set A has the upper case characters and then the control characters, set B the printable characters
+        text_append(writer, set == 'A' && value >= 64 ? value - 64 : value + ' ');
+    } else if(value == CODE_128_SHIFT) {
+        state->shift = true;
+    } else if(value == CODE_128_CODE_C) {
+        state->set = 'C';
+    } else if(set == 'A' && value == CODE_128_CODE_B) {
+        state->set = 'B';
+    } else if(set == 'B' && value == CODE_128_CODE_A) {
+        state->set = 'A';
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Decodes a Code 128 barcode and checks its check codeword
+ * A codeword is only decoded once the next one is read, so the last codeword before the stop is the check codeword
+*/
+static BarcodeDecodeResult code_128_decode(ModuleReader* reader, TextWriter* writer) {
+    if(!reader_has(reader, CODE_128_CODEWORD_MODULES + CODE_128_STOP_MODULES)) {
+        return BarcodeDecodeInvalidPattern;
+    }
+
+    int start = code_128_codeword(reader_bits(reader, CODE_128_CODEWORD_MODULES));
+    if(start < CODE_128_START_A || start > CODE_128_START_C) {
+        return BarcodeDecodeInvalidPattern;
+    }
+
+    Code128State state = {.set = 'A' + start - CODE_128_START_A, .shift = false};
+    int checksum = start;
+    int position = 0;
+    int pending = -1;
+
+    while(reader_has(reader, CODE_128_CODEWORD_MODULES + CODE_128_STOP_MODULES)) {
+        int value = code_128_codeword(reader_bits(reader, CODE_128_CODEWORD_MODULES));
+        if(value < 0 || value >= CODE_128_START_A) {
+            return BarcodeDecodeInvalidPattern;
+        }
+
+        if(pending >= 0) {
+            if(!code_128_decode_codeword(&state, pending, writer)) {
+                return BarcodeDecodeInvalidPattern;
+            }
+            position++;
+            checksum += pending * position;
+        }
+        pending = value;
+    }
+
+    if(pending < 0 || reader->end - reader->position != CODE_128_STOP_MODULES ||
+       reader_bits(reader, CODE_128_STOP_MODULES) != CODE_128_PATTERNS[CODE_128_STOP] ||
+       state.shift) {
+        return BarcodeDecodeInvalidPattern;
+    }
+    return checksum % 103 == pending ? BarcodeDecodeOK : BarcodeDecodeWrongCheck;
+}
+
+/**
+ * Decodes the modules of a barcode the way a scanner would read them
+ * @param text  the decoded text, always null terminated, also filled in if the check fails
+ * @param size  the size of text, atleast 1
+*/
+BarcodeDecodeResult
+    barcode_decode(BarcodeType type, const ModuleBuffer* modules, char* text, size_t size) {
+    const BarcodeTypeObj* type_obj = &barcode_type_objs[type];
+    ModuleReader reader;
+    reader_init(&reader, modules);
+    TextWriter writer = {.text = text, .size = size, .length = 0, .overflow = false};
+    text[0] = '\0';
+
+    BarcodeDecodeResult result;
+    if(type_obj->layout != NULL) {
+        result = ean_upc_decode(type_obj->layout, &reader, &writer);
+    } else if(type_obj->elements != NULL) {
+        result = wide_narrow_decode(type_obj, &reader, &writer);
+    } else if(type_obj->encoder == &CODE_128_ENCODER) {
+        result = code_128_decode(&reader, &writer);
+    } else {
+        result = BarcodeDecodeUnsupportedType;
+    }
+
+    return result == BarcodeDecodeOK && writer.overflow ? BarcodeDecodeTextTooLong : result;
+}
+
+/**
+ * Decodes a row of pixels, every module is drawn as a single pixel
+ * @param row  xbm bitmap of the row, the leftmost pixel is the least significant bit of the first byte
+ * @param modules  the row is copied into it as modules, must have room for width modules
+*/
+BarcodeDecodeResult barcode_decode_row(
+    BarcodeType type,
+    const uint8_t* row,
+    size_t width,
+    ModuleBuffer* modules,
+    char* text,
+    size_t size) {
+    module_buffer_reset(modules);
+    for(size_t x = 0; x < width; x++) {
+        module_buffer_append(modules, (row[x >> 3] >> (x & 7)) & 1);
+    }
+    return barcode_decode(type, modules, text, size);
+}
+
+/**
+ * The text a scanner reads from a barcode of the data, to compare with the decoded text
+ * EAN/UPC have their correct check digit, Code 39 and Codabar are upper case with the missing delimiters
+ * @returns false if the text didn't fit
+*/
+bool barcode_decode_expected(
+    BarcodeType type,
+    const char* data,
+    size_t length,
+    char* text,
+    size_t size) {
+    const BarcodeTypeObj* type_obj = &barcode_type_objs[type];
+    TextWriter writer = {.text = text, .size = size, .length = 0, .overflow = false};
+    text[0] = '\0';
+
+    const EanUpcLayout* layout = type_obj->layout;
+    if(layout != NULL) {
+        for(size_t i = 0; i + 1 < layout->digit_count && i < length; i++) {
+            text_append(&writer, data[i]);
+        }
+        text_append(&writer, '0' + ean_upc_check_digit(data, layout->digit_count - 1));
+    } else if(type_obj->elements != NULL) {
+        char delimiter = type_obj->delimiter;
+        if(delimiter != 0 && (length == 0 || data[0] != delimiter)) {
+            text_append(&writer, delimiter);
+        }
+        for(size_t i = 0; i < length; i++) {
+            text_append(&writer, toupper((unsigned char)data[i]));
+        }
+        if(delimiter != 0 && (length == 0 || data[length - 1] != delimiter)) {
+            text_append(&writer, delimiter);
+        }
+    } else {
+        for(size_t i = 0; i < length; i++) {
+            text_append(&writer, data[i]);
+        }
+    }
+    return !writer.overflow;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+ * Decodes the modules of the barcodes this app encodes, part of the core so it only uses the C standard library
+ * It reads modules the way a scanner would, so an encoded barcode can be checked by decoding it again
+*/
+
+#include "barcode_types.h"
+#include "module_buffer.h"
+
+typedef enum {
+    BarcodeDecodeOK,
+    BarcodeDecodeUnsupportedType, //the type has no decoder
+    BarcodeDecodeInvalidPattern, //the modules are not a barcode of the type
+    BarcodeDecodeWrongCheck, //the check digit or check codeword doesn't match the data
+    BarcodeDecodeTextTooLong, //the decoded text doesn't fit in the text buffer
+} BarcodeDecodeResult;
+
+BarcodeDecodeResult
+    barcode_decode(BarcodeType type, const ModuleBuffer* modules, char* text, size_t size);
+BarcodeDecodeResult barcode_decode_row(
+    BarcodeType type,
+    const uint8_t* row,
+    size_t width,
+    ModuleBuffer* modules,
+    char* text,
+    size_t size);
+bool barcode_decode_expected(
+    BarcodeType type,
+    const char* data,
+    size_t length,
+    char* text,
+    size_t size);
+const char* barcode_decode_result_name(BarcodeDecodeResult result);
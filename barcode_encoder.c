@@ -0,0 +1,485 @@
+#include "barcode_encoder.h"
+#include "encodings.h"
+
+#include <ctype.h>
+
+//the Code 128 code sets, when two encodings are equally short the earlier set is used
+typedef enum {
+    Code128SetB,
+    Code128SetA,
+    Code128SetC,
+
+    Code128SetCount
+} Code128Set;
+
+static const uint8_t code_128_start_codewords[Code128SetCount] = {
+    [Code128SetA] = CODE_128_START_A,
+    [Code128SetB] = CODE_128_START_B,
+    [Code128SetC] = CODE_128_START_C};
+
+static const uint8_t code_128_latch_codewords[Code128SetCount] = {
+    [Code128SetA] = CODE_128_CODE_A,
+    [Code128SetB] = CODE_128_CODE_B,
+    [Code128SetC] = CODE_128_CODE_C};
+
+//a step of the shortest Code 128 encoding, the set to latch to and if the character is shifted
+#define CODE_128_STEP_SET_MASK 0x03
+#define CODE_128_STEP_SHIFT 0x04
+
+//the cost of a character that can't be encoded in a set, adding the cost of the rest of the data can't overflow
+#define CODE_128_NO_COST (UINT32_MAX / 2)
+
+const EanUpcLayout UPC_A_LAYOUT = {.digit_count = 12, .first_digit = 0, .left_digits = 6, .parity = NULL};
+const EanUpcLayout EAN_8_LAYOUT = {.digit_count = 8, .first_digit = 0, .left_digits = 4, .parity = NULL};
+const EanUpcLayout EAN_13_LAYOUT =
+    {.digit_count = 13, .first_digit = 1, .left_digits = 6, .parity = EAN_13_PARITY};
+
+/**
+ * @returns the wide/narrow elements of a Code 39 or Codabar character or NULL if it can't be encoded
+*/
+static const char* wide_narrow_elements(const BarcodeTypeObj* type_obj, char character) {
+    unsigned char index = toupper((unsigned char)character);
+    if(index >= 128) {
+        return NULL;
+    }
+    return type_obj->elements[index];
+}
+
+/**
+ * @returns the number of modules of a wide/narrow character including the space after it
+*/
+static size_t wide_narrow_size(const char* elements) {
+    size_t size = 1;
+    for(size_t i = 0; elements[i] != '\0'; i++) {
+        size += elements[i] == '1' ? 3 : 1;
+    }
+    return size;
+}
+
+/**
+ * Appends the modules of a character that is encoded with wide and narrow elements (Code 39 & Codabar)
+ * @param elements  the elements alternate between bars and spaces, always begins with a bar
+ *                  1 for a wide element (3 modules), 0 for a narrow element (1 module)
+ * A narrow space is added after the character to separate it from the next one
+*/
+static void append_wide_narrow_modules(ModuleBuffer* modules, const char* elements) {
+    for(int i = 0; elements[i] != '\0'; i++) {
+        module_buffer_append_run(modules, (i & 1) == 0, elements[i] == '1' ? 3 : 1);
+    }
+    module_buffer_append(modules, false);
+}
+
+/**
+ * Some types must begin and end with a delimiter (the * of Code 39), they are added when the data doesn't have them
+ * The data itself is never changed, the missing delimiters are encoded around it
+*/
+static bool needs_start_delimiter(const BarcodeTypeObj* type_obj, const char* data, size_t length) {
+    return type_obj->delimiter != 0 && (length == 0 || data[0] != type_obj->delimiter);
+}
+
+static bool needs_stop_delimiter(const BarcodeTypeObj* type_obj, const char* data, size_t length) {
+    return type_obj->delimiter != 0 && (length == 0 || data[length - 1] != type_obj->delimiter);
+}
+
+/**
+ * The number of modules of an EAN/UPC barcode
+ * start & end guards (3 each), center guard (5) and 7 modules per digit that has bars
+*/
+static size_t ean_upc_encoded_size(const BarcodeTypeObj* type_obj, const char* data, size_t length) {
+    BARCODE_UNUSED(data);
+    BARCODE_UNUSED(length);
+    const EanUpcLayout* layout = type_obj->layout;
+    return 11 + (layout->digit_count - layout->first_digit) * EAN_UPC_DIGIT_MODULES;
+}
+
+/**
+ * The number of modules of a Code 39 or Codabar barcode, characters that can't be encoded are not counted
+*/
+static size_t wide_narrow_encoded_size(const BarcodeTypeObj* type_obj, const char* data, size_t length) {
+    size_t size = 0;
+    for(size_t i = 0; i < length; i++) {
+        const char* elements = wide_narrow_elements(type_obj, data[i]);
+        if(elements != NULL) {
+            size += wide_narrow_size(elements);
+        }
+    }
+
+    size_t delimiters = needs_start_delimiter(type_obj, data, length) +
+                        needs_stop_delimiter(type_obj, data, length);
+    if(delimiters > 0) {
+        size += delimiters * wide_narrow_size(wide_narrow_elements(type_obj, type_obj->delimiter));
+    }
+    return size;
+}
+
+/**
+ * The number of modules of a Code 128 barcode
+ * This is an upper bound since the code sets are picked while encoding, it is the start, the check codeword,
+ * the stop codeword and the worst case where every character needs a shift codeword before it
+*/
+static size_t code_128_encoded_size(const BarcodeTypeObj* type_obj, const char* data, size_t length) {
+    BARCODE_UNUSED(type_obj);
+    BARCODE_UNUSED(data);
+    return (length * 2 + 2) * CODE_128_CODEWORD_MODULES + CODE_128_STOP_MODULES;
+}
+
+/**
+ * The cost and the step of every position in every code set
+*/
+static size_t code_128_scratch_size(size_t length) {
+    return (length + 1) * Code128SetCount * (sizeof(uint32_t) + sizeof(uint8_t));
+}
+
+/**
+ * Calculates the number of modules needed to encode the data, use it to size the output buffer
+ * The size is exact for data that can be encoded, characters that can't be encoded are not counted
+ * Code 128 is the exception, the size is an upper bound since the code sets are picked while encoding
+ * @returns the number of modules or 0 if the type is unsupported
+*/
+size_t barcode_encoded_size(BarcodeType type, const char* data, size_t length) {
+    const BarcodeTypeObj* type_obj = &barcode_type_objs[type];
+    if(type_obj->encoder == NULL) {
+        return 0;
+    }
+    return type_obj->encoder->encoded_size(type_obj, data, length);
+}
+
+/**
+ * @returns the number of scratch bytes barcode_encode needs for the type
+*/
+size_t barcode_scratch_size(BarcodeType type, size_t length) {
+    const BarcodeTypeObj* type_obj = &barcode_type_objs[type];
+    if(type_obj->encoder == NULL || type_obj->encoder->scratch_size == NULL) {
+        return 0;
+    }
+    return type_obj->encoder->scratch_size(length);
+}
+
+/**
+ * Calculates the check digit of barcode types UPC-A, EAN-8, & EAN-13
+ * The digit next to the check digit has a weight of 3, the weights alternate between 3 and 1 from there
+ * @param digits  the digits of the barcode, only the first length digits are used
+ * @param length  the number of digits without the check digit
+*/
+int ean_upc_check_digit(const char* digits, size_t length) {
+    int sum = 0;
+    for(size_t i = 0; i < length; i++) {
+        int digit = digits[i] - '0';
+        sum += (length - i) & 1 ? digit * 3 : digit;
+    }
+
+    return (10 - sum % 10) % 10;
+}
+
+/**
+ * Encodes an EAN-8, EAN-13, or UPC-A barcode, the guard patterns are flagged in the module buffer
+ * The data may leave out the check digit, a check digit in the data is replaced with the correct one
+ * @param layout  the variant's layout, the calls use a constant layout so they can be specialized
+*/
+static inline ErrorCode ean_upc_encode(
+    const EanUpcLayout* layout,
+    const char* data,
+    size_t length,
+    ModuleBuffer* out) {
+    //check the length of the barcode
+    if(length != layout->digit_count && length != layout->digit_count - 1u) {
+        return WrongNumberOfDigits;
+    }
+
+    //checks if the barcode contains any characters that aren't a number
+    for(size_t i = 0; i < length; i++) {
+        if(!isdigit((unsigned char)data[i])) {
+            return InvalidCharacters;
+        }
+    }
+
+    int check_digit = ean_upc_check_digit(data, layout->digit_count - 1);
+
+    //EAN-13 does not draw the first digit, it is encoded in the L/G parity of the left half
+    uint8_t parity = layout->parity != NULL ? layout->parity[data[0] - '0'] : 0;
+
+    module_buffer_append_guard_bits(out, EAN_UPC_SIDE_GUARD, 3);
+
+    for(size_t i = layout->first_digit; i < layout->digit_count; i++) {
+        int digit = i == layout->digit_count - 1u ? check_digit : data[i] - '0';
+        size_t position = i - layout->first_digit;
+
+        //use the L-codes (or G-codes) for the left half and the R-Codes for the right half
+        uint8_t code;
+        if(position < layout->left_digits) {
+            bool g_code = (parity >> (layout->left_digits - 1 - position)) & 1;
+            code = g_code ? EAN_G_CODES[digit] : UPC_EAN_L_CODES[digit];
+        } else {
+            code = UPC_EAN_R_CODES[digit];
+        }
+        module_buffer_append_bits(out, code, EAN_UPC_DIGIT_MODULES);
+
+        if(position == layout->left_digits - 1u) {
+            module_buffer_append_guard_bits(out, EAN_UPC_CENTER_GUARD, 5);
+        }
+    }
+
+    module_buffer_append_guard_bits(out, EAN_UPC_SIDE_GUARD, 3);
+    return OKCode;
+}
+
+/**
+ * Every EAN/UPC variant calls ean_upc_encode with its own constant layout
+*/
+#define EAN_UPC_ENCODER(encoder_name, function_name, variant_layout)                   \
+    static ErrorCode function_name(                                                   \
+        const BarcodeTypeObj* type_obj,                                               \
+        const char* data,                                                             \
+        size_t length,                                                                \
+        ModuleBuffer* out,                                                            \
+        BarcodeScratch* scratch) {                                                    \
+        BARCODE_UNUSED(type_obj);                                                             \
+        BARCODE_UNUSED(scratch);                                                              \
+        return ean_upc_encode(&variant_layout, data, length, out);                    \
+    }                                                                                 \
+    const BarcodeEncoder encoder_name = {                                             \
+        .encode = function_name, .encoded_size = ean_upc_encoded_size, .scratch_size = NULL};
+
+EAN_UPC_ENCODER(UPC_A_ENCODER, upc_a_encode, UPC_A_LAYOUT)
+EAN_UPC_ENCODER(EAN_8_ENCODER, ean_8_encode, EAN_8_LAYOUT)
+EAN_UPC_ENCODER(EAN_13_ENCODER, ean_13_encode, EAN_13_LAYOUT)
+
+#undef EAN_UPC_ENCODER
+
+/**
+ * Encodes a Code 39 or Codabar barcode
+*/
+static ErrorCode wide_narrow_encode(
+    const BarcodeTypeObj* type_obj,
+    const char* data,
+    size_t length,
+    ModuleBuffer* out,
+    BarcodeScratch* scratch) {
+    BARCODE_UNUSED(scratch);
+
+    //must contain atleast a character,
+    //this can have as many characters as it wants, it might not fit on the screen
+    if(length < (size_t)type_obj->min_digits) {
+        return WrongNumberOfDigits;
+    }
+
+    for(size_t i = 0; i < length; i++) {
+        if(wide_narrow_elements(type_obj, data[i]) == NULL) {
+            return InvalidCharacters;
+        }
+    }
+
+    if(needs_start_delimiter(type_obj, data, length)) {
+        append_wide_narrow_modules(out, wide_narrow_elements(type_obj, type_obj->delimiter));
+    }
+
+    for(size_t i = 0; i < length; i++) {
+        append_wide_narrow_modules(out, wide_narrow_elements(type_obj, data[i]));
+    }
+
+    if(needs_stop_delimiter(type_obj, data, length)) {
+        append_wide_narrow_modules(out, wide_narrow_elements(type_obj, type_obj->delimiter));
+    }
+    return OKCode;
+}
+
+const BarcodeEncoder WIDE_NARROW_ENCODER = {
+    .encode = wide_narrow_encode,
+    .encoded_size = wide_narrow_encoded_size,
+    .scratch_size = NULL};
+
+/**
+ * Writes Code 128 codewords and keeps the running checksum
+*/
+typedef struct {
+    ModuleBuffer* out;
+    int checksum; //the start codeword plus the sum of every codeword times its position
+    int position; //the number of codewords written after the start codeword
+} Code128Writer;
+
+/**
+ * Appends the pattern of a Code 128 codeword
+*/
+static void code_128_append(ModuleBuffer* out, int codeword) {
+    module_buffer_append_bits(
+        out,
+        CODE_128_PATTERNS[codeword],
+        codeword == CODE_128_STOP ? CODE_128_STOP_MODULES : CODE_128_CODEWORD_MODULES);
+}
+
+static void code_128_write(Code128Writer* writer, int codeword) {
+    code_128_append(writer->out, codeword);
+    writer->position++;
+    writer->checksum += codeword * writer->position;
+}
+
+/**
+ * @returns the value of a character in code set A or B, or -1 if the set doesn't have the character
+ * Set A has the control characters and the upper case characters, set B the printable characters
+*/
+static int code_128_value(Code128Set set, unsigned char character) {
+    if(set == Code128SetA) {
+        if(character < ' ') {
+            return character + 64;
+        }
+        return character < '`' ? character - ' ' : -1;
+    }
+    return character >= ' ' && character < 128 ? character - ' ' : -1;
+}
+
+/**
+ * @returns true if there are two digits at index, set C encodes them as a single codeword
+*/
+static bool code_128_is_digit_pair(const char* data, size_t length, size_t index) {
+    return index + 1 < length && isdigit((unsigned char)data[index]) &&
+           isdigit((unsigned char)data[index + 1]);
+}
+
+/**
+ * Finds the shortest sequence of codewords with a pass from the end of the data to the beginning
+ * cost[i][set] is the fewest codewords needed to encode the data from i on when in that set
+ * A character can be encoded in the current set, shifted between sets A and B for a single character,
+ * or the set can be latched to another set first
+ * @returns the code set to start with
+*/
+static Code128Set code_128_find_steps(
+    const char* data,
+    size_t length,
+    uint32_t (*cost)[Code128SetCount],
+    uint8_t (*steps)[Code128SetCount]) {
+    for(int set = 0; set < Code128SetCount; set++) {
+        cost[length][set] = 0;
+        steps[length][set] = set;
+    }
+
+    for(size_t i = length; i-- > 0;) {
+        //the cost of encoding the next character without latching to another set
+        uint32_t encode_cost[Code128SetCount];
+        for(int set = 0; set < Code128SetCount; set++) {
+            encode_cost[set] = CODE_128_NO_COST;
+            steps[i][set] = set;
+
+            if(set == Code128SetC) {
+                if(code_128_is_digit_pair(data, length, i)) {
+                    encode_cost[set] = 1 + cost[i + 2][set];
+                }
+            } else if(code_128_value(set, data[i]) >= 0) {
+                encode_cost[set] = 1 + cost[i + 1][set];
+            } else {
+                //the character is only in the other set, shift to it for this character
+                encode_cost[set] = 2 + cost[i + 1][set];
+                steps[i][set] |= CODE_128_STEP_SHIFT;
+            }
+        }
+
+        for(int set = 0; set < Code128SetCount; set++) {
+            uint32_t best = encode_cost[set];
+            for(int target = 0; target < Code128SetCount; target++) {
+                if(target != set && 1 + encode_cost[target] < best) {
+                    best = 1 + encode_cost[target];
+                    steps[i][set] = (steps[i][set] & ~CODE_128_STEP_SET_MASK) | target;
+                }
+            }
+            cost[i][set] = best;
+        }
+    }
+
+    //starting in a set never needs a latch at the first character since that set could be started instead
+    Code128Set start = Code128SetB;
+    for(int set = 0; set < Code128SetCount; set++) {
+        if(cost[0][set] < cost[0][start]) {
+            start = set;
+        }
+    }
+    return start;
+}
+
+/**
+ * Encodes a Code 128 barcode with the fewest codewords by switching between code sets A, B, and C
+ * CODE128C is the same encoder but only accepts digits
+*/
+static ErrorCode code_128_encode(
+    const BarcodeTypeObj* type_obj,
+    const char* data,
+    size_t length,
+    ModuleBuffer* out,
+    BarcodeScratch* scratch) {
+    //code 128 C needs atleast a pair of digits
+    if(length < (size_t)type_obj->min_digits) {
+        return WrongNumberOfDigits;
+    }
+
+    bool digits_only = type_obj->type == CODE128C;
+    for(size_t i = 0; i < length; i++) {
+        unsigned char character = data[i];
+        bool valid = digits_only ? isdigit(character) : character < 128;
+        if(!valid) {
+            return InvalidCharacters;
+        }
+    }
+
+    if(scratch == NULL || scratch->data == NULL || scratch->size < code_128_scratch_size(length)) {
+        return ScratchTooSmall;
+    }
+    uint32_t(*cost)[Code128SetCount] = (uint32_t(*)[Code128SetCount])scratch->data;
+    uint8_t(*steps)[Code128SetCount] = (uint8_t(*)[Code128SetCount])(cost + length + 1);
+    Code128Set set = code_128_find_steps(data, length, cost, steps);
+
+    Code128Writer writer = {.out = out, .checksum = code_128_start_codewords[set], .position = 0};
+    code_128_append(out, code_128_start_codewords[set]);
+
+    size_t i = 0;
+    while(i < length) {
+        Code128Set target = steps[i][set] & CODE_128_STEP_SET_MASK;
+        if(target != set) {
+            code_128_write(&writer, code_128_latch_codewords[target]);
+            set = target;
+        }
+
+        if(set == Code128SetC) {
+            //set C encodes pairs of digits, the pair's value is the number they represent
+            code_128_write(&writer, (data[i] - '0') * 10 + (data[i + 1] - '0'));
+            i += 2;
+        } else if(steps[i][set] & CODE_128_STEP_SHIFT) {
+            Code128Set other = set == Code128SetA ? Code128SetB : Code128SetA;
+            code_128_write(&writer, CODE_128_SHIFT);
+            code_128_write(&writer, code_128_value(other, data[i]));
+            i++;
+        } else {
+            code_128_write(&writer, code_128_value(set, data[i]));
+            i++;
+        }
+    }
+
+    //add the check codeword and the stop code
+    code_128_append(out, writer.checksum % 103);
+    code_128_append(out, CODE_128_STOP);
+    return OKCode;
+}
+
+const BarcodeEncoder CODE_128_ENCODER = {
+    .encode = code_128_encode,
+    .encoded_size = code_128_encoded_size,
+    .scratch_size = code_128_scratch_size};
+
+/**
+ * Encodes data into a barcode's modules
+ * Nothing is allocated and data is never modified, everything is written to out
+ * @param data  the barcode data, it does not need to be null terminated
+ * @param out  must have room for barcode_encoded_size modules
+ * @param scratch  must have barcode_scratch_size bytes, can be NULL if that is 0
+ * @returns OKCode if the data was encoded, otherwise the reason why it couldn't be, ScratchTooSmall if
+ * the type needs scratch and scratch has fewer than barcode_scratch_size bytes
+*/
+ErrorCode barcode_encode(
+    BarcodeType type,
+    const char* data,
+    size_t length,
+    ModuleBuffer* out,
+    BarcodeScratch* scratch) {
+    const BarcodeTypeObj* type_obj = &barcode_type_objs[type];
+    if(type_obj->encoder == NULL) {
+        return UnsupportedType;
+    }
+    return type_obj->encoder->encode(type_obj, data, length, out, scratch);
+}
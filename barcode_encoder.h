@@ -0,0 +1,24 @@
+#pragma once
+
+#include "barcode_types.h"
+#include "module_buffer.h"
+
+extern const BarcodeEncoder UPC_A_ENCODER;
+extern const BarcodeEncoder EAN_8_ENCODER;
+extern const BarcodeEncoder EAN_13_ENCODER;
+extern const BarcodeEncoder WIDE_NARROW_ENCODER;
+extern const BarcodeEncoder CODE_128_ENCODER;
+
+extern const EanUpcLayout UPC_A_LAYOUT;
+extern const EanUpcLayout EAN_8_LAYOUT;
+extern const EanUpcLayout EAN_13_LAYOUT;
+
+size_t barcode_encoded_size(BarcodeType type, const char* data, size_t length);
+size_t barcode_scratch_size(BarcodeType type, size_t length);
+ErrorCode barcode_encode(
+    BarcodeType type,
+    const char* data,
+    size_t length,
+    ModuleBuffer* out,
+    BarcodeScratch* scratch);
+int ean_upc_check_digit(const char* digits, size_t length);
@@ -0,0 +1,35 @@
+#pragma once
+
+/**
+ * The golden barcodes, the bars of every one of them are checked against golden_bars/NAME.pbm
+ * The PBM images are made by scripts/gen_goldens.py from barcode_encoding_files and the EAN/UPC
+ * specification, not by the encoder, so a change to the encoder or the renderer can't change its goldens
+ * The goldens are checked by host/golden.c and by the golden app arguments of debug builds
+ *
+ * X(type, data, name)
+ *  type - the name of the barcode type, as in the barcode files
+ *  data - the data of the barcode
+ *  name - the name of the PBM image in golden_bars, without the extension
+*/
+#define BARCODE_GOLDENS(X)                                \
+    X("UPC-A", "12345678901", "upc-a_1")                  \
+    X("UPC-A", "123456789012", "upc-a_2")                 \
+    X("UPC-A", "036000291452", "upc-a_3")                 \
+    X("EAN-8", "1234567", "ean-8_1")                      \
+    X("EAN-8", "12345670", "ean-8_2")                     \
+    X("EAN-13", "590123412345", "ean-13_1")               \
+    X("EAN-13", "5901234123457", "ean-13_2")              \
+    X("CODE-39", "HELLO", "code-39_1")                    \
+    X("CODE-39", "*ABC-12 $/+%*", "code-39_2")            \
+    X("CODE-128", "Hello World!", "code-128_1")           \
+    X("CODE-128", "#tag~{}", "code-128_2")                \
+    X("CODE-128", "ABC123456789", "code-128_3")           \
+    X("CODE-128", "a", "code-128_4")                      \
+    X("CODE-128C", "1234567890", "code-128c_1")           \
+    X("CODE-128C", "00990001", "code-128c_2")             \
+    X("Codabar", "A1234A", "codabar_1")                   \
+    X("Codabar", "b40156B", "codabar_2")                  \
+    X("Codabar", "C1-2$3:4/5.6+7D", "codabar_3")
+
+//the folder of the golden PBM images in the repository, copy it to the SD card for the golden app arguments
+#define BARCODE_GOLDEN_BARS "golden_bars"
@@ -0,0 +1,46 @@
+#pragma once
+
+/**
+ * Log macros of the app with a compile-time level, the macros of the levels above BARCODE_LOG_LEVEL
+ * compile to nothing so their arguments are never formatted
+ * FURI_LOG_* only checks the log level when it runs, after the arguments have been evaluated
+*/
+
+#include <furi.h>
+
+#define BARCODE_LOG_LEVEL_NONE 0
+#define BARCODE_LOG_LEVEL_ERROR 1
+#define BARCODE_LOG_LEVEL_INFO 2
+#define BARCODE_LOG_LEVEL_VERBOSE 3 //lines that are written for every barcode that is loaded or drawn
+
+//the most detailed log lines that are compiled in, build with -DBARCODE_LOG_LEVEL=3 for the verbose lines
+//debug builds write what the verbose lines say to the timing trace as binary events instead
+#ifndef BARCODE_LOG_LEVEL
+#define BARCODE_LOG_LEVEL BARCODE_LOG_LEVEL_INFO
+#endif
+
+//the arguments of a log line that isn't compiled in are still type checked, the compiler removes the call
+#define BARCODE_LOG_NOTHING(...)          \
+    do {                                  \
+        if(0) {                           \
+            FURI_LOG_I(TAG, __VA_ARGS__); \
+        }                                 \
+    } while(0)
+
+#if BARCODE_LOG_LEVEL >= BARCODE_LOG_LEVEL_ERROR
+#define BARCODE_LOG_E(...) FURI_LOG_E(TAG, __VA_ARGS__)
+#else
+#define BARCODE_LOG_E(...) BARCODE_LOG_NOTHING(__VA_ARGS__)
+#endif
+
+#if BARCODE_LOG_LEVEL >= BARCODE_LOG_LEVEL_INFO
+#define BARCODE_LOG_I(...) FURI_LOG_I(TAG, __VA_ARGS__)
+#else
+#define BARCODE_LOG_I(...) BARCODE_LOG_NOTHING(__VA_ARGS__)
+#endif
+
+#if BARCODE_LOG_LEVEL >= BARCODE_LOG_LEVEL_VERBOSE
+#define BARCODE_LOG_V(...) FURI_LOG_I(TAG, __VA_ARGS__)
+#else
+#define BARCODE_LOG_V(...) BARCODE_LOG_NOTHING(__VA_ARGS__)
+#endif
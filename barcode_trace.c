@@ -0,0 +1,72 @@
+#include "barcode_app.h"
+
+#ifdef BARCODE_DEBUG
+
+static BarcodeTracePoint trace_points[BARCODE_TRACE_SIZE];
+
+//the number of trace points written so far, the next point goes to trace_count % BARCODE_TRACE_SIZE
+static uint32_t trace_count;
+
+/**
+ * Adds a trace point to the ring buffer, the draw callback runs on the GUI thread so this can be
+ * called from more than one thread
+ * @param stage  the BarcodeTraceStage, use barcode_trace_begin and barcode_trace_end
+ * @param type  the BarcodeType or BARCODE_TRACE_NO_TYPE
+ * @param length  the length of the barcode data
+*/
+void barcode_trace(uint8_t stage, uint8_t type, size_t length) {
+    FURI_CRITICAL_ENTER();
+    BarcodeTracePoint* point = &trace_points[trace_count % BARCODE_TRACE_SIZE];
+    point->cycles = DWT->CYCCNT;
+    point->length = length > UINT16_MAX ? UINT16_MAX : length;
+    point->stage = stage;
+    point->type = type;
+    trace_count++;
+    FURI_CRITICAL_EXIT();
+}
+
+/**
+ * Writes the trace points to BARCODE_TRACE_FILE from oldest to newest
+ * The points are copied first so the trace can keep going while the file is written
+ * @returns true if the file was written
+*/
+bool barcode_trace_flush() {
+    BarcodeTracePoint* points = malloc(sizeof(trace_points));
+
+    FURI_CRITICAL_ENTER();
+    uint32_t count = MIN(trace_count, (uint32_t)BARCODE_TRACE_SIZE);
+    uint32_t oldest = trace_count - count;
+    for(uint32_t i = 0; i < count; i++) {
+        points[i] = trace_points[(oldest + i) % BARCODE_TRACE_SIZE];
+    }
+    FURI_CRITICAL_EXIT();
+
+    BarcodeTraceHeader header = {
+        .magic = BARCODE_TRACE_MAGIC,
+        .version = BARCODE_TRACE_VERSION,
+        .point_size = sizeof(BarcodeTracePoint),
+        .count = count,
+        .cycles_per_us = furi_hal_cortex_instructions_per_microsecond(),
+    };
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    bool success = storage_file_open(file, BARCODE_TRACE_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                   storage_file_write(file, &header, sizeof(header)) == sizeof(header) &&
+                   storage_file_write(file, points, sizeof(BarcodeTracePoint) * count) ==
+                       sizeof(BarcodeTracePoint) * count;
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    free(points);
+
+    if(success) {
+        BARCODE_LOG_I("Wrote %lu trace points to %s", (unsigned long)count, BARCODE_TRACE_FILE);
+    } else {
+        BARCODE_LOG_E("Could not write %s", BARCODE_TRACE_FILE);
+    }
+    return success;
+}
+
+#endif
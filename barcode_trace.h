@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * Timing trace of the stages of loading, drawing, saving and removing barcodes, in debug builds only
+ * Every trace point writes 8 bytes to a ring buffer in RAM, so the trace can stay on and the slow cases on
+ * a device can be looked at afterwards
+ * The buffer is written to BARCODE_TRACE_FILE when BARCODE_TRACE_KEYS are pressed in the barcode view,
+ * scripts/barcode_trace.py summarises the file
+ * The trace also gets events that would otherwise be a formatted log line for every load
+ * Release builds have no trace, the trace points compile to nothing
+*/
+
+#include <furi.h>
+#include <furi_hal.h>
+
+//defines BARCODE_DEBUG in FURI_DEBUG builds
+#include "barcode_alloc.h"
+
+//the file the trace is written to, a header followed by the trace points from oldest to newest
+#define BARCODE_TRACE_FILE EXT_PATH("apps_data/barcodes/timing.bin")
+#define BARCODE_TRACE_MAGIC "BCTR"
+#define BARCODE_TRACE_VERSION 1
+
+//the number of trace points that are kept, the oldest points are overwritten
+#define BARCODE_TRACE_SIZE 128
+
+//the type of the trace points that aren't about a barcode type
+#define BARCODE_TRACE_NO_TYPE 0xFF
+
+//the stage of a trace point that ends a stage has this bit set
+#define BARCODE_TRACE_END 0x80
+
+//the stage of a trace point that is a single event instead of the begin or end of a stage has this bit set
+#define BARCODE_TRACE_EVENT 0x40
+
+typedef enum {
+    BarcodeTraceSelect, //picking a barcode file and loading it
+    BarcodeTraceReadFile, //reading the type and data from the barcode file
+    BarcodeTraceEncode, //encoding the modules of the barcode
+    BarcodeTraceRuns, //building the text and the runs of the barcode
+    BarcodeTraceDraw, //drawing the barcode view
+    BarcodeTraceSave, //saving a barcode file
+    BarcodeTraceRemove, //removing a barcode file
+    //event of debug builds, the peak bytes (length) of a BarcodeDebugPhase (type), the heap peak for reading the file
+    BarcodeTraceMemory,
+
+    BarcodeTraceStageCount
+} BarcodeTraceStage;
+
+/**
+ * A trace point as it is kept in RAM and written to the file
+*/
+typedef struct {
+    uint32_t cycles; //the DWT cycle counter, it wraps about once a minute so only differences count
+    uint16_t length; //the length of the barcode data or the value of an event, UINT16_MAX if it is larger
+    uint8_t stage; //the BarcodeTraceStage, with BARCODE_TRACE_END if the point ends the stage
+    uint8_t type; //the BarcodeType or BARCODE_TRACE_NO_TYPE
+} BarcodeTracePoint;
+
+/**
+ * The header of the trace file
+*/
+typedef struct {
+    char magic[4]; //BARCODE_TRACE_MAGIC
+    uint8_t version; //BARCODE_TRACE_VERSION
+    uint8_t point_size; //sizeof(BarcodeTracePoint)
+    uint16_t count; //the number of trace points that follow
+    uint32_t cycles_per_us; //to convert the cycles of the trace points to time
+} BarcodeTraceHeader;
+
+#ifdef BARCODE_DEBUG
+
+void barcode_trace(uint8_t stage, uint8_t type, size_t length);
+bool barcode_trace_flush();
+
+#define barcode_trace_begin(stage, type, length) barcode_trace(stage, type, length)
+#define barcode_trace_end(stage, type, length) \
+    barcode_trace((stage) | BARCODE_TRACE_END, type, length)
+#define barcode_trace_event(stage, type, length) \
+    barcode_trace((stage) | BARCODE_TRACE_EVENT, type, length)
+
+#else
+
+//the arguments of a trace point are still type checked, sizeof does not evaluate them
+#define BARCODE_TRACE_NOTHING(stage, type, length) ((void)sizeof((stage) + (type) + (length)))
+
+#define barcode_trace_begin(stage, type, length) BARCODE_TRACE_NOTHING(stage, type, length)
+#define barcode_trace_end(stage, type, length) BARCODE_TRACE_NOTHING(stage, type, length)
+#define barcode_trace_event(stage, type, length) BARCODE_TRACE_NOTHING(stage, type, length)
+
+#endif
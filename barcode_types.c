@@ -0,0 +1,57 @@
+#include "barcode_types.h"
+#include "barcode_encoder.h"
+#include "encodings.h"
+
+#include <string.h>
+
+#define BARCODE_TYPE_OBJ(                                                                   \
+    barcode_type, type_name, min, max, start, type_encoder, check, type_layout, elements_table, \
+    delimiter_char)                                                                         \
+    [barcode_type] = {                                                                      \
+        .name = type_name,                                                                  \
+        .name_length = sizeof(type_name) - 1,                                               \
+        .type = barcode_type,                                                               \
+        .min_digits = min,                                                                  \
+        .max_digits = max,                                                                  \
+        .start_pos = start,                                                                 \
+        .encoder = type_encoder,                                                            \
+        .check_digit = check,                                                               \
+        .layout = type_layout,                                                              \
+        .elements = elements_table,                                                         \
+        .delimiter = delimiter_char},
+
+const BarcodeTypeObj barcode_type_objs[NUMBER_OF_BARCODE_TYPES] = {
+    BARCODE_TYPES(BARCODE_TYPE_OBJ)
+
+    [UNKNOWN] = {
+        .name = "Unknown",
+        .name_length = sizeof("Unknown") - 1,
+        .type = UNKNOWN,
+        .min_digits = 0,
+        .max_digits = 0,
+        .start_pos = 0,
+        .encoder = NULL,
+        .check_digit = NULL,
+        .layout = NULL,
+        .elements = NULL,
+        .delimiter = 0},
+};
+
+#undef BARCODE_TYPE_OBJ
+
+/**
+ * Finds a barcode type by its name, only the names with the same length are compared
+ * This scans every type instead of looking the name up in buckets by length: with seven types the scan
+ * compares at most two names, the buckets could not be built from BARCODE_TYPES at compile time
+ * @returns the barcode type or the UNKNOWN type if there is no type with that name
+*/
+const BarcodeTypeObj* get_type_by_name(const char* name, size_t length) {
+    for(int i = 0; i < UNKNOWN; i++) {
+        const BarcodeTypeObj* type_obj = &barcode_type_objs[i];
+        if(type_obj->name_length == length && memcmp(type_obj->name, name, length) == 0) {
+            return type_obj;
+        }
+    }
+
+    return &barcode_type_objs[UNKNOWN];
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+/**
+ * The barcode types and the errors of the encoding core
+ * The encoding core (barcode_types, barcode_encoder, encodings, module_buffer) only uses the C standard library,
+ * it does not depend on furi so it can also be compiled and profiled on a computer
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "module_buffer.h"
+
+//the furi UNUSED macro for code that can't include furi
+#define BARCODE_UNUSED(x) (void)(x)
+
+typedef enum {
+    WrongNumberOfDigits, //There is too many or too few digits in the barcode
+    InvalidCharacters, //The barcode contains invalid characters
+    UnsupportedType, //the barcode type is not supported
+    FileOpening, //A problem occurred when opening the barcode data file
+    InvalidFileData, //One of the key in the file doesn't exist or there is a typo
+    ScratchTooSmall, //the scratch passed to the encoder is missing or smaller than barcode_scratch_size
+    OKCode
+} ErrorCode;
+
+/**
+ * Every supported barcode type, adding a type only needs a new line here
+ * The order is the order the types are shown in when creating a barcode
+ * 
+ * X(type, name, min_digits, max_digits, start_pos, encoder, check_digit, layout, elements, delimiter)
+ *  type - the BarcodeType enum
+ *  name - the name of the type, this is how the type is saved in the barcode files
+ *  min_digits/max_digits - the number of characters, set max_digits to -1 for no limit
+ *  start_pos - where to start drawing the barcode, set to -1 to dynamically draw barcode
+ *  encoder - the BarcodeEncoder that encodes the type
+ *  check_digit - calculates the check digit, NULL if the type has none
+ *  layout - the EanUpcLayout of EAN/UPC types, NULL for the other types
+ *  elements - the wide/narrow elements of every character (Code 39 & Codabar), NULL for the other types
+ *  delimiter - the character the data must begin and end with, added if it is missing, 0 for none
+*/
+#define BARCODE_TYPES(X)                                                                          \
+    X(UPCA, "UPC-A", 11, 12, 16, &UPC_A_ENCODER, ean_upc_check_digit, &UPC_A_LAYOUT, NULL, 0)     \
+    X(EAN8, "EAN-8", 7, 8, 32, &EAN_8_ENCODER, ean_upc_check_digit, &EAN_8_LAYOUT, NULL, 0)       \
+    X(EAN13, "EAN-13", 12, 13, 16, &EAN_13_ENCODER, ean_upc_check_digit, &EAN_13_LAYOUT, NULL, 0) \
+    X(CODE39, "CODE-39", 1, -1, 0, &WIDE_NARROW_ENCODER, NULL, NULL, CODE_39_ENCODINGS, '*')      \
+    X(CODE128, "CODE-128", 1, -1, 0, &CODE_128_ENCODER, NULL, NULL, NULL, 0)                      \
+    X(CODE128C, "CODE-128C", 2, -1, 0, &CODE_128_ENCODER, NULL, NULL, NULL, 0)                    \
+    X(CODABAR, "Codabar", 1, -1, 0, &WIDE_NARROW_ENCODER, NULL, NULL, CODABAR_ENCODINGS, 0)
+
+typedef enum {
+#define BARCODE_TYPE_ENUM(type, ...) type,
+    BARCODE_TYPES(BARCODE_TYPE_ENUM)
+#undef BARCODE_TYPE_ENUM
+
+    UNKNOWN,
+
+    NUMBER_OF_BARCODE_TYPES
+} BarcodeType;
+
+typedef struct BarcodeTypeObj BarcodeTypeObj;
+
+/**
+ * Working memory for the encoder, owned by the caller so the encoder never has to allocate
+ * barcode_scratch_size tells how many bytes a barcode needs, most barcodes need none
+*/
+typedef struct {
+    uint8_t* data;
+    size_t size; //the number of bytes in data
+} BarcodeScratch;
+
+/**
+ * Encodes a family of barcode types, the type_obj tells the encoder which type of the family to encode
+*/
+typedef struct {
+    //encodes the data into out, returns OKCode or the reason the data could not be encoded
+    ErrorCode (*encode)(
+        const BarcodeTypeObj* type_obj,
+        const char* data,
+        size_t length,
+        ModuleBuffer* out,
+        BarcodeScratch* scratch);
+    //the number of modules needed to encode the data
+    size_t (*encoded_size)(const BarcodeTypeObj* type_obj, const char* data, size_t length);
+    //the number of scratch bytes needed to encode length characters, NULL if no scratch is needed
+    size_t (*scratch_size)(size_t length);
+} BarcodeEncoder;
+
+/**
+ * Describes how the digits of an EAN/UPC variant are laid out
+*/
+typedef struct {
+    uint8_t digit_count; //the number of digits including the check digit
+    uint8_t first_digit; //the number of leading digits without bars (EAN-13 encodes its first digit in the parity)
+    uint8_t left_digits; //the number of digits with bars left of the center guard pattern
+    const uint8_t* parity; //the L/G parity of the left digits indexed by the first digit, NULL for only L-codes
+} EanUpcLayout;
+
+struct BarcodeTypeObj {
+    const char* name; //The name of the barcode type
+    uint8_t name_length; //the length of the name, used to look up the type without comparing every name
+    BarcodeType type; //The barcode type enum
+    int min_digits; //the minimum number of digits
+    int max_digits; //the maximum number of digits
+    int start_pos; //where to start drawing the barcode, set to -1 to dynamically draw barcode
+    const BarcodeEncoder* encoder; //the encoder of the type, NULL if the type can't be encoded
+    int (*check_digit)(const char* digits, size_t length); //NULL if the type has no check digit
+    const EanUpcLayout* layout; //the layout of the digits of EAN/UPC types, NULL to center the data instead
+    const char* const* elements; //the wide/narrow elements of every character (Code 39 & Codabar)
+    char delimiter; //the character the data must begin and end with, 0 for none
+};
+
+//All available barcode types indexed by their BarcodeType, the last one is UNKNOWN
+extern const BarcodeTypeObj barcode_type_objs[NUMBER_OF_BARCODE_TYPES];
+
+const BarcodeTypeObj* get_type_by_name(const char* name, size_t length);
@@ -3,53 +3,30 @@
 #include <furi.h>
 #include <furi_hal.h>
 
-#define NUMBER_OF_BARCODE_TYPES 8 
+#include "barcode_types.h"
+#include "module_buffer.h"
 
-typedef enum {
-    WrongNumberOfDigits, //There is too many or too few digits in the barcode
-    InvalidCharacters, //The barcode contains invalid characters
-    UnsupportedType, //the barcode type is not supported
-    FileOpening, //A problem occurred when opening the barcode data file
-    InvalidFileData, //One of the key in the file doesn't exist or there is a typo
-    MissingEncodingTable, //The encoding table txt for the barcode type is missing
-    EncodingTableError, //Something is wrong with the encoding table, probably missing data or typo
-    OKCode
-} ErrorCode;
-
-typedef enum {
-    UPCA,
-    EAN8,
-    EAN13,
-    CODE39,
-    CODE128,
-    CODE128C,
-    CODABAR,
-
-    UNKNOWN
-} BarcodeType;
+//set on a run's width when the bar is a guard bar, guard bars are drawn longer (EAN-8, EAN-13, UPC-A)
+#define BARCODE_RUN_GUARD 0x80
+#define BARCODE_RUN_WIDTH_MASK 0x7F
 
 typedef struct {
-    char* name; //The name of the barcode type
-    BarcodeType type; //The barcode type enum
-    int min_digits; //the minimum number of digits
-    int max_digits; //the maximum number of digits
-    int start_pos; //where to start drawing the barcode, set to -1 to dynamically draw barcode
-} BarcodeTypeObj;
+    uint8_t* widths; //the widths of the alternating bars and spaces, always begins with a bar
+    size_t count; //the number of runs
+    int total_width; //the width of the whole barcode in modules
+} BarcodeRuns;
 
 typedef struct {
-    BarcodeTypeObj* type_obj;
+    const BarcodeTypeObj* type_obj;
     int check_digit; //A place to store the check digit
     FuriString* raw_data; //the data directly from the file
-    FuriString* correct_data; //the corrected/processed data
+    FuriString* correct_data; //the corrected/processed data, this is the text shown under the barcode
+    ModuleBuffer* modules; //the encoded barcode, one bit per module
+    BarcodeRuns runs; //the bars and spaces of the encoded barcode, built once the barcode is loaded
     bool valid; //true if the raw data is correctly formatted, such as correct num of digits, valid characters, etc.
     ErrorCode reason; //the reason why this barcode is invalid
 } BarcodeData;
 
-//All available barcode types
-extern BarcodeTypeObj* barcode_type_objs[NUMBER_OF_BARCODE_TYPES];
-
-void init_types();
-void free_types();
-BarcodeTypeObj* get_type(FuriString* type_string);
+const BarcodeTypeObj* get_type(FuriString* type_string);
 const char* get_error_code_name(ErrorCode error_code);
 const char* get_error_code_message(ErrorCode error_code);
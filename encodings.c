@@ -1,52 +1,257 @@
 #include "encodings.h"
 
-const char EAN_13_STRUCTURE_CODES[10][6] = {
-    "LLLLLL",
-    "LLGLGG",
-    "LLGGLG",
-    "LLGGGL",
-    "LGLLGG",
-    "LGGLLG",
-    "LGGGLL",
-    "LGLGLG",
-    "LGLGGL",
-    "LGGLGL"};
+/**
+ * The parity of the 6 digits left of the center of an EAN-13 barcode, indexed by the first digit
+ * The first digit has no bars, it is encoded in which left digits use the G-codes
+ * Bit 5 is the first left digit, a set bit means the digit uses its G-code, a cleared bit its L-code
+*/
+const uint8_t EAN_13_PARITY[10] = {
+    0x00, // 0 LLLLLL
+    0x0B, // 1 LLGLGG
+    0x0D, // 2 LLGGLG
+    0x0E, // 3 LLGGGL
+    0x13, // 4 LGLLGG
+    0x19, // 5 LGGLLG
+    0x1C, // 6 LGGGLL
+    0x15, // 7 LGLGLG
+    0x16, // 8 LGLGGL
+    0x1A // 9 LGGLGL
+};
+
+/**
+ * The EAN/UPC digit codes, 7 modules per digit stored in the lowest 7 bits, msb first
+*/
+const uint8_t UPC_EAN_L_CODES[10] = {
+    0x0D, // 0 0001101
+    0x19, // 1 0011001
+    0x13, // 2 0010011
+    0x3D, // 3 0111101
+    0x23, // 4 0100011
+    0x31, // 5 0110001
+    0x2F, // 6 0101111
+    0x3B, // 7 0111011
+    0x37, // 8 0110111
+    0x0B // 9 0001011
+};
 
-const char UPC_EAN_L_CODES[10][8] = {
-    "0001101", // 0
-    "0011001", // 1
-    "0010011", // 2
-    "0111101", // 3
-    "0100011", // 4
-    "0110001", // 5
-    "0101111", // 6
-    "0111011", // 7
-    "0110111", // 8
-    "0001011" // 9
+const uint8_t EAN_G_CODES[10] = {
+    0x27, // 0 0100111
+    0x33, // 1 0110011
+    0x1B, // 2 0011011
+    0x21, // 3 0100001
+    0x1D, // 4 0011101
+    0x39, // 5 0111001
+    0x05, // 6 0000101
+    0x11, // 7 0010001
+    0x09, // 8 0001001
+    0x17 // 9 0010111
 };
 
-const char EAN_G_CODES[10][8] = {
-    "0100111", // 0
-    "0110011", // 1
-    "0011011", // 2
-    "0100001", // 3
-    "0011101", // 4
-    "0111001", // 5
-    "0000101", // 6
-    "0010001", // 7
-    "0001001", // 8
-    "0010111" // 9
+const uint8_t UPC_EAN_R_CODES[10] = {
+    0x72, // 0 1110010
+    0x66, // 1 1100110
+    0x6C, // 2 1101100
+    0x42, // 3 1000010
+    0x5C, // 4 1011100
+    0x4E, // 5 1001110
+    0x50, // 6 1010000
+    0x44, // 7 1000100
+    0x48, // 8 1001000
+    0x74 // 9 1110100
 };
 
-const char UPC_EAN_R_CODES[10][8] = {
-    "1110010", // 0
-    "1100110", // 1
-    "1101100", // 2
-    "1000010", // 3
-    "1011100", // 4
-    "1001110", // 5
-    "1010000", // 6
-    "1000100", // 7
-    "1001000", // 8
-    "1110100" // 9
-};
\ No newline at end of file
+/**
+ * Code 39 encodings indexed by character
+ * 9 elements that alternate between bars and spaces, always begins with a bar
+ * 0 for narrow, 1 for wide
+ * NULL if the character can not be encoded
+*/
+const char* const CODE_39_ENCODINGS[128] = {
+    ['0'] = "000110100",
+    ['1'] = "100100001",
+    ['2'] = "001100001",
+    ['3'] = "101100000",
+    ['4'] = "000110001",
+    ['5'] = "100110000",
+    ['6'] = "001110000",
+    ['7'] = "000100101",
+    ['8'] = "100100100",
+    ['9'] = "001100100",
+    ['A'] = "100001001",
+    ['B'] = "001001001",
+    ['C'] = "101001000",
+    ['D'] = "000011001",
+    ['E'] = "100011000",
+    ['F'] = "001011000",
+    ['G'] = "000001101",
+    ['H'] = "100001100",
+    ['I'] = "001001100",
+    ['J'] = "000011100",
+    ['K'] = "100000011",
+    ['L'] = "001000011",
+    ['M'] = "101000010",
+    ['N'] = "000010011",
+    ['O'] = "100010010",
+    ['P'] = "001010010",
+    ['Q'] = "000000111",
+    ['R'] = "100000110",
+    ['S'] = "001000110",
+    ['T'] = "000010110",
+    ['U'] = "110000001",
+    ['V'] = "011000001",
+    ['W'] = "111000000",
+    ['X'] = "010010001",
+    ['Y'] = "110010000",
+    ['Z'] = "011010000",
+    ['-'] = "010000101",
+    ['.'] = "110000100",
+    [' '] = "011000100",
+    ['*'] = "010010100",
+    ['$'] = "010101000",
+    ['/'] = "010100010",
+    ['+'] = "010001010",
+    ['%'] = "000101010"};
+
+/**
+ * Codabar encodings indexed by character
+ * 7 elements that alternate between bars and spaces, always begins with a bar
+ * 0 for narrow, 1 for wide
+ * NULL if the character can not be encoded
+*/
+const char* const CODABAR_ENCODINGS[128] = {
+    ['0'] = "0000011",
+    ['1'] = "0000110",
+    ['2'] = "0001001",
+    ['3'] = "1100000",
+    ['4'] = "0010010",
+    ['5'] = "1000010",
+    ['6'] = "0100001",
+    ['7'] = "0100100",
+    ['8'] = "0110000",
+    ['9'] = "1001000",
+    ['-'] = "0001100",
+    ['$'] = "0011000",
+    [':'] = "1000101",
+    ['/'] = "1010001",
+    ['.'] = "1010100",
+    ['+'] = "0010101",
+    ['A'] = "0011010",
+    ['B'] = "0101001",
+    ['C'] = "0001011",
+    ['D'] = "0001110"};
+
+/**
+ * Code 128 patterns indexed by the codeword value (0-106)
+ * Each pattern holds its modules msb first, 11 modules per codeword and 13 for the stop codeword
+ * Set B characters have a value of their ascii code - 32
+ * Set C digit pairs have a value of the number they represent
+*/
+const uint16_t CODE_128_PATTERNS[107] = {
+    0x06CC, // 0 11011001100
+    0x066C, // 1 11001101100
+    0x0666, // 2 11001100110
+    0x0498, // 3 10010011000
+    0x048C, // 4 10010001100
+    0x044C, // 5 10001001100
+    0x04C8, // 6 10011001000
+    0x04C4, // 7 10011000100
+    0x0464, // 8 10001100100
+    0x0648, // 9 11001001000
+    0x0644, // 10 11001000100
+    0x0624, // 11 11000100100
+    0x059C, // 12 10110011100
+    0x04DC, // 13 10011011100
+    0x04CE, // 14 10011001110
+    0x05CC, // 15 10111001100
+    0x04EC, // 16 10011101100
+    0x04E6, // 17 10011100110
+    0x0672, // 18 11001110010
+    0x065C, // 19 11001011100
+    0x064E, // 20 11001001110
+    0x06E4, // 21 11011100100
+    0x0674, // 22 11001110100
+    0x076E, // 23 11101101110
+    0x074C, // 24 11101001100
+    0x072C, // 25 11100101100
+    0x0726, // 26 11100100110
+    0x0764, // 27 11101100100
+    0x0734, // 28 11100110100
+    0x0732, // 29 11100110010
+    0x06D8, // 30 11011011000
+    0x06C6, // 31 11011000110
+    0x0636, // 32 11000110110
+    0x0518, // 33 10100011000
+    0x0458, // 34 10001011000
+    0x0446, // 35 10001000110
+    0x0588, // 36 10110001000
+    0x0468, // 37 10001101000
+    0x0462, // 38 10001100010
+    0x0688, // 39 11010001000
+    0x0628, // 40 11000101000
+    0x0622, // 41 11000100010
+    0x05B8, // 42 10110111000
+    0x058E, // 43 10110001110
+    0x046E, // 44 10001101110
+    0x05D8, // 45 10111011000
+    0x05C6, // 46 10111000110
+    0x0476, // 47 10001110110
+    0x0776, // 48 11101110110
+    0x068E, // 49 11010001110
+    0x062E, // 50 11000101110
+    0x06E8, // 51 11011101000
+    0x06E2, // 52 11011100010
+    0x06EE, // 53 11011101110
+    0x0758, // 54 11101011000
+    0x0746, // 55 11101000110
+    0x0716, // 56 11100010110
+    0x0768, // 57 11101101000
+    0x0762, // 58 11101100010
+    0x071A, // 59 11100011010
+    0x077A, // 60 11101111010
+    0x0642, // 61 11001000010
+    0x078A, // 62 11110001010
+    0x0530, // 63 10100110000
+    0x050C, // 64 10100001100
+    0x04B0, // 65 10010110000
+    0x0486, // 66 10010000110
+    0x042C, // 67 10000101100
+    0x0426, // 68 10000100110
+    0x0590, // 69 10110010000
+    0x0584, // 70 10110000100
+    0x04D0, // 71 10011010000
+    0x04C2, // 72 10011000010
+    0x0434, // 73 10000110100
+    0x0432, // 74 10000110010
+    0x0612, // 75 11000010010
+    0x0650, // 76 11001010000
+    0x07BA, // 77 11110111010
+    0x0614, // 78 11000010100
+    0x047A, // 79 10001111010
+    0x053C, // 80 10100111100
+    0x04BC, // 81 10010111100
+    0x049E, // 82 10010011110
+    0x05E4, // 83 10111100100
+    0x04F4, // 84 10011110100
+    0x04F2, // 85 10011110010
+    0x07A4, // 86 11110100100
+    0x0794, // 87 11110010100
+    0x0792, // 88 11110010010
+    0x06DE, // 89 11011011110
+    0x06F6, // 90 11011110110
+    0x07B6, // 91 11110110110
+    0x0578, // 92 10101111000
+    0x051E, // 93 10100011110
+    0x045E, // 94 10001011110
+    0x05E8, // 95 10111101000
+    0x05E2, // 96 10111100010
+    0x07A8, // 97 11110101000
+    0x07A2, // 98 11110100010
+    0x05DE, // 99 10111011110
+    0x05EE, // 100 10111101110
+    0x075E, // 101 11101011110
+    0x07AE, // 102 11110101110
+    0x0684, // 103 11010000100 START A
+    0x0690, // 104 11010010000 START B
+    0x069C, // 105 11010011100 START C
+    0x18EB // 106 1100011101011 STOP
+};
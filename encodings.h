@@ -1,6 +1,34 @@
 #pragma once
 
-extern const char EAN_13_STRUCTURE_CODES[10][6];
-extern const char UPC_EAN_L_CODES[10][8];
-extern const char EAN_G_CODES[10][8];
-extern const char UPC_EAN_R_CODES[10][8];
\ No newline at end of file
+#include <stdint.h>
+
+//the number of modules of an EAN/UPC digit
+#define EAN_UPC_DIGIT_MODULES 7
+
+//the EAN/UPC guard patterns, 3 modules for the start and end guards and 5 for the center guard
+#define EAN_UPC_SIDE_GUARD 0x05
+#define EAN_UPC_CENTER_GUARD 0x0A
+
+extern const uint8_t EAN_13_PARITY[10];
+extern const uint8_t UPC_EAN_L_CODES[10];
+extern const uint8_t EAN_G_CODES[10];
+extern const uint8_t UPC_EAN_R_CODES[10];
+
+extern const char* const CODE_39_ENCODINGS[128];
+extern const char* const CODABAR_ENCODINGS[128];
+
+//the number of modules of a Code 128 codeword, the stop codeword has 2 more
+#define CODE_128_CODEWORD_MODULES 11
+#define CODE_128_STOP_MODULES 13
+
+//Code 128 codewords that are not characters
+#define CODE_128_SHIFT 98
+#define CODE_128_CODE_C 99
+#define CODE_128_CODE_B 100
+#define CODE_128_CODE_A 101
+#define CODE_128_START_A 103
+#define CODE_128_START_B 104
+#define CODE_128_START_C 105
+#define CODE_128_STOP 106
+
+extern const uint16_t CODE_128_PATTERNS[107];
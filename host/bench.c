@@ -0,0 +1,102 @@
+/**
+ * Runs the benchmark of the encoding core on a computer, the same benchmark the flipper runs in debug builds
+ * usage: bench [--csv] [--baseline FILE] [--threshold PERCENT] [--max-length N] [--min-time-ms N]
+ * The report is written to stdout as JSON (or CSV), a JSON report can be used as the baseline of a later run
+ * @returns 1 if a result is slower than the baseline by more than the threshold
+*/
+
+#include "barcode_bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static uint64_t host_clock_ns(void* context) {
+    (void)context;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+static void host_writer(void* context, const char* text, size_t length) {
+    fwrite(text, 1, length, context);
+}
+
+/**
+ * @returns the null terminated text of a file that has to be freed, or NULL if it could not be read
+*/
+static char* read_file(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if(file == NULL) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* text = malloc(size + 1);
+    text[fread(text, 1, size, file)] = '\0';
+    fclose(file);
+    return text;
+}
+
+int main(int argc, char** argv) {
+    BarcodeBenchConfig config = {
+        .clock = host_clock_ns,
+        .clock_context = NULL,
+        .min_time_ns = 20000000,
+        .max_length = BARCODE_BENCH_MAX_LENGTH,
+    };
+    bool csv = false;
+    const char* baseline_path = NULL;
+    uint32_t threshold = BARCODE_BENCH_DEFAULT_THRESHOLD;
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else if(strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if(strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--max-length") == 0 && i + 1 < argc) {
+            config.max_length = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--min-time-ms") == 0 && i + 1 < argc) {
+            config.min_time_ns = strtoull(argv[++i], NULL, 10) * 1000000;
+        } else {
+            fprintf(
+                stderr,
+                "usage: %s [--csv] [--baseline FILE] [--threshold PERCENT] [--max-length N] "
+                "[--min-time-ms N]\n",
+                argv[0]);
+            return 2;
+        }
+    }
+
+    size_t count = barcode_bench_count(&config);
+    BarcodeBenchResult* results = malloc(sizeof(BarcodeBenchResult) * count);
+    count = barcode_bench_run(&config, results, count);
+
+    size_t regressions = 0;
+    if(baseline_path != NULL) {
+        char* baseline = read_file(baseline_path);
+        if(baseline == NULL) {
+            fprintf(stderr, "could not read %s\n", baseline_path);
+            free(results);
+            return 2;
+        }
+        regressions = barcode_bench_compare(results, count, baseline, threshold);
+        free(baseline);
+    }
+
+    if(csv) {
+        barcode_bench_write_csv(results, count, host_writer, stdout);
+    } else {
+        barcode_bench_write_json(results, count, host_writer, stdout);
+    }
+    if(regressions > 0) {
+        fprintf(stderr, "%zu results are more than %u%% slower than the baseline\n", regressions, threshold);
+    }
+
+    free(results);
+    return regressions > 0 ? 1 : 0;
+}
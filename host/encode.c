@@ -0,0 +1,45 @@
+/**
+ * Encodes a barcode with the encoding core and prints its modules, 1 for a bar and 0 for a space
+ * usage: encode TYPE DATA
+ * TYPE is the name the barcode files use, for example EAN-13 or CODE-128
+*/
+
+#include "barcode_encoder.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char** argv) {
+    if(argc != 3) {
+        fprintf(stderr, "usage: %s TYPE DATA\n", argv[0]);
+        return 2;
+    }
+
+    const BarcodeTypeObj* type_obj = get_type_by_name(argv[1], strlen(argv[1]));
+    if(type_obj->type == UNKNOWN) {
+        fprintf(stderr, "unknown type %s\n", argv[1]);
+        return 2;
+    }
+
+    const char* data = argv[2];
+    size_t length = strlen(data);
+    ModuleBuffer* modules =
+        module_buffer_alloc(barcode_encoded_size(type_obj->type, data, length));
+    BarcodeScratch scratch = {.size = barcode_scratch_size(type_obj->type, length)};
+    scratch.data = malloc(scratch.size);
+
+    ErrorCode result = barcode_encode(type_obj->type, data, length, modules, &scratch);
+    if(result == OKCode) {
+        for(size_t i = 0; i < module_buffer_size(modules); i++) {
+            putchar(module_buffer_get(modules, i) ? '1' : '0');
+        }
+        putchar('\n');
+    } else {
+        fprintf(stderr, "could not encode the data, error %d\n", result);
+    }
+
+    free(scratch.data);
+    module_buffer_free(modules);
+    return result == OKCode ? 0 : 1;
+}
@@ -0,0 +1,296 @@
+/**
+ * Draws the views of the app into the canvas of sdk/ and measures every frame, built with the SDK of sdk/
+ * The create view, the message view, the keyboard and the barcode view with every renderer are drawn for
+ * every golden barcode of barcode_goldens.h, like the frames app arguments of debug builds do on a Flipper
+ * The canvas calls of the first draw of a view are counted, the later draws are timed and the frame is
+ * written to the folder as a binary PBM image, frames.json in the folder has the calls and the times
+ * The times are the ones of the computer, and the canvas of sdk/ draws no text
+ * usage: frames [--folder FOLDER]
+ * @returns 1 if a view made no canvas calls or drew an empty frame
+*/
+
+#define _GNU_SOURCE
+
+#include "barcode_app.h"
+#include "barcode_goldens.h"
+#include "host_sdk.h"
+
+#include <inttypes.h>
+#include <sys/stat.h>
+#include <time.h>
+
+//the folder the frames are written to, set by the Makefile
+#ifndef FRAMES_FOLDER
+#define FRAMES_FOLDER "build/view_frames"
+#endif
+
+//how many times every frame is drawn after the first draw to time it, the same as BARCODE_FRAMES_REPEAT
+#define FRAMES_REPEAT 32
+
+#define FRAMES_PBM_HEADER "P4\n128 64\n"
+#define FRAMES_ROW_BYTES (128 / 8)
+#define FRAMES_PBM_SIZE (sizeof(FRAMES_PBM_HEADER) - 1 + FRAMES_ROW_BYTES * 64)
+
+typedef struct {
+    const char* type;
+    const char* data;
+    const char* name;
+} FramesGolden;
+
+static const FramesGolden goldens[] = {
+#define FRAMES_GOLDEN(type, data, name) {type, data, name},
+    BARCODE_GOLDENS(FRAMES_GOLDEN)
+#undef FRAMES_GOLDEN
+};
+
+static const char* const call_names[HostCanvasCallCount] = {
+    [HostCanvasClear] = "clear",
+    [HostCanvasSetColor] = "set_color",
+    [HostCanvasSetFont] = "set_font",
+    [HostCanvasStringWidth] = "string_width",
+    [HostCanvasDrawDot] = "draw_dot",
+    [HostCanvasDrawBox] = "draw_box",
+    [HostCanvasDrawFrame] = "draw_frame",
+    [HostCanvasDrawRFrame] = "draw_rframe",
+    [HostCanvasDrawXbm] = "draw_xbm",
+    [HostCanvasDrawIcon] = "draw_icon",
+    [HostCanvasDrawGlyph] = "draw_glyph",
+    [HostCanvasDrawStr] = "draw_str",
+    [HostCanvasDrawStrAligned] = "draw_str_aligned",
+    [HostCanvasMultilineText] = "multiline_text",
+    [HostCanvasMultilineTextAligned] = "multiline_text_aligned",
+    [HostCanvasRoundedBox] = "slightly_rounded_box",
+    [HostCanvasRoundedFrame] = "slightly_rounded_frame",
+};
+
+typedef struct {
+    const char* folder;
+    Canvas* canvas;
+    FILE* report;
+    bool first; //true until the first frame is written to the report
+    size_t failed;
+} Frames;
+
+static uint64_t frames_clock_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+/**
+ * Writes the frame on the canvas as a binary PBM image, see debug_frames_pbm of barcode_debug.c
+ * @returns false if the frame is empty
+*/
+static bool frames_write_pbm(Frames* frames, const char* name) {
+    const uint8_t* buffer = canvas_get_buffer(frames->canvas);
+    uint8_t pbm[FRAMES_PBM_SIZE];
+
+    memcpy(pbm, FRAMES_PBM_HEADER, sizeof(FRAMES_PBM_HEADER) - 1);
+    uint8_t* row = pbm + sizeof(FRAMES_PBM_HEADER) - 1;
+    memset(row, 0, FRAMES_ROW_BYTES * 64);
+    bool drawn = false;
+    for(size_t y = 0; y < 64; y++, row += FRAMES_ROW_BYTES) {
+        for(size_t x = 0; x < 128; x++) {
+            if(buffer[(y >> 3) * 128 + x] & (1 << (y & 7))) {
+                row[x >> 3] |= 0x80 >> (x & 7);
+                drawn = true;
+            }
+        }
+    }
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s.pbm", frames->folder, name);
+    FILE* file = fopen(path, "wb");
+    if(file == NULL || fwrite(pbm, 1, sizeof(pbm), file) != sizeof(pbm)) {
+        fprintf(stderr, "could not write %s\n", path);
+    }
+    if(file != NULL) {
+        fclose(file);
+    }
+    return drawn;
+}
+
+/**
+ * Draws a view, counts the canvas calls of the first draw and times the first and the later draws
+ * The frame is written to the folder and a line is added to the report
+*/
+static void frames_measure(Frames* frames, View* view, const char* view_name, const FramesGolden* golden) {
+    host_sdk_reset_canvas_calls();
+    uint64_t start = frames_clock_ns();
+    host_view_draw(view, frames->canvas);
+    uint64_t first_ns = frames_clock_ns() - start;
+
+    uint32_t calls[HostCanvasCallCount];
+    uint32_t total_calls = 0;
+    for(int i = 0; i < HostCanvasCallCount; i++) {
+        calls[i] = host_sdk_canvas_calls(i);
+        total_calls += calls[i];
+    }
+
+    start = frames_clock_ns();
+    for(int i = 0; i < FRAMES_REPEAT; i++) {
+        host_view_draw(view, frames->canvas);
+    }
+    uint64_t ns_per_frame = (frames_clock_ns() - start) / FRAMES_REPEAT;
+
+    char name[64];
+    snprintf(name, sizeof(name), "%s_%s", view_name, golden->name);
+    bool drawn = frames_write_pbm(frames, name);
+
+    fprintf(
+        frames->report,
+        "%s{\"view\":\"%s\",\"type\":\"%s\",\"barcode\":\"%s\",\"first_ns\":%" PRIu64
+        ",\"ns_per_frame\":%" PRIu64 ",\"calls\":%" PRIu32,
+        frames->first ? "" : ",\n",
+        view_name,
+        golden->type,
+        golden->name,
+        first_ns,
+        ns_per_frame,
+        total_calls);
+    for(int i = 0; i < HostCanvasCallCount; i++) {
+        if(calls[i] > 0) {
+            fprintf(frames->report, ",\"%s\":%" PRIu32, call_names[i], calls[i]);
+        }
+    }
+    fputc('}', frames->report);
+    frames->first = false;
+
+    bool ok = total_calls > 0 && drawn;
+    printf(
+        "%-14s %-12s %4" PRIu32 " calls %8" PRIu64 " ns first %8" PRIu64 " ns per frame%s\n",
+        view_name,
+        golden->name,
+        total_calls,
+        first_ns,
+        ns_per_frame,
+        ok ? "" : ", nothing drawn");
+    frames->failed += !ok;
+}
+
+static void frames_text_result(void* context) {
+    UNUSED(context);
+}
+
+static void frames_set_renderer(Barcode* barcode, BarcodeRenderer renderer) {
+    with_view_model(
+        barcode->view,
+        BarcodeModel * model,
+        {
+            model->renderer = renderer;
+            model->render.ready = false;
+        },
+        false);
+}
+
+int main(int argc, char** argv) {
+    const char* folder = FRAMES_FOLDER;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--folder") == 0 && i + 1 < argc) {
+            folder = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--folder FOLDER]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/frames.json", folder);
+    mkdir(folder, 0755);
+    Frames frames = {.folder = folder, .report = fopen(path, "w"), .first = true, .failed = 0};
+    if(frames.report == NULL) {
+        fprintf(stderr, "could not write %s\n", path);
+        return 2;
+    }
+    fputs("{\"frames\":[\n", frames.report);
+    furi_log_set_level(FuriLogLevelWarn);
+
+    static const struct {
+        const char* name;
+        BarcodeRenderer renderer;
+    } renderers[] = {
+        {"barcode-boxes", BarcodeRendererBoxes},
+        {"barcode-rows", BarcodeRendererRowBitmap},
+    };
+
+    BarcodeApp app = {0};
+    app.create_view = create_view_allocate(&app);
+    app.message_view = message_view_allocate(&app);
+    app.barcode_view = barcode_view_allocate(&app);
+    app.text_input = text_input_alloc();
+
+    Gui* gui = furi_record_open(RECORD_GUI);
+    frames.canvas = gui_direct_draw_acquire(gui);
+
+    //the create view edits the barcode, the keyboard edits its data and the message view says it was saved
+    with_view_model(
+        create_get_view(app.create_view),
+        CreateViewModel * model,
+        {
+            model->selected_menu_item = 0;
+            model->file_path = furi_string_alloc();
+            model->file_name = furi_string_alloc();
+            model->barcode_data = furi_string_alloc();
+            model->mode = EditMode;
+        },
+        false);
+    with_view_model(
+        message_get_view(app.message_view),
+        MessageViewModel * model,
+        { model->message = "File Saved!"; },
+        false);
+    char text[TEXT_BUFFER_SIZE];
+    text_input_set_header_text(app.text_input, "Barcode Data");
+
+    FuriString* file_path = furi_string_alloc();
+    FuriString* type = furi_string_alloc();
+    FuriString* data = furi_string_alloc();
+    for(size_t i = 0; i < sizeof(goldens) / sizeof(goldens[0]); i++) {
+        const FramesGolden* golden = &goldens[i];
+        const BarcodeTypeObj* type_obj = get_type_by_name(golden->type, strlen(golden->type));
+
+        with_view_model(
+            create_get_view(app.create_view),
+            CreateViewModel * model,
+            {
+                model->barcode_type = type_obj;
+                furi_string_set(model->file_name, golden->name);
+                furi_string_set(model->barcode_data, golden->data);
+            },
+            false);
+        frames_measure(&frames, create_get_view(app.create_view), "create", golden);
+
+        strlcpy(text, golden->data, sizeof(text));
+        text_input_set_result_callback(
+            app.text_input, frames_text_result, NULL, text, sizeof(text), false);
+        text_input_show_illegal_symbols(app.text_input, true);
+        frames_measure(&frames, text_input_get_view(app.text_input), "text_input", golden);
+
+        frames_measure(&frames, message_get_view(app.message_view), "message", golden);
+
+        furi_string_printf(file_path, "%s/%s%s", DEFAULT_USER_BARCODES, golden->name, BARCODE_EXTENSION);
+        furi_string_set(type, golden->type);
+        furi_string_set(data, golden->data);
+        set_barcode_data(app.barcode_view, file_path, type, data, OKCode);
+        for(size_t j = 0; j < sizeof(renderers) / sizeof(renderers[0]); j++) {
+            frames_set_renderer(app.barcode_view, renderers[j].renderer);
+            frames_measure(&frames, app.barcode_view->view, renderers[j].name, golden);
+        }
+    }
+    furi_string_free(file_path);
+    furi_string_free(type);
+    furi_string_free(data);
+
+    fputs("\n]}\n", frames.report);
+    fclose(frames.report);
+    gui_direct_draw_release(gui);
+    furi_record_close(RECORD_GUI);
+
+    create_view_free(app.create_view);
+    message_view_free(app.message_view);
+    barcode_free(app.barcode_view);
+    text_input_free(app.text_input);
+
+    printf("%zu views drew nothing, the frames are in %s\n", frames.failed, folder);
+    return frames.failed > 0;
+}
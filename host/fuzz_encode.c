@@ -0,0 +1,183 @@
+/**
+ * Fuzzes the encoding core, the first byte of an input picks the barcode type and the rest is the data
+ * Every input that encodes has to decode to the text a scanner would read, and every input has to free
+ * what it allocated
+ * The same target is built two ways:
+ *   make fuzz    a libFuzzer target, needs clang: build/fuzz_encode_libfuzzer CORPUS_FOLDER
+ *   make         a standalone driver for any compiler, it replays the files it is given or, without
+ *                files, runs random inputs: fuzz_encode [--runs N] [--seed N] [FILE...]
+ * An input that fails aborts, so libFuzzer keeps it as a crash that the standalone driver can replay
+*/
+
+#include "barcode_alloc.h"
+#include "barcode_decoder.h"
+#include "barcode_encoder.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//the longest data that is encoded, longer than the limit of the app so the limit is fuzzed too
+#define FUZZ_MAX_LENGTH 512
+
+//the decoded text has the check digits and delimiters on top of the data
+#define FUZZ_TEXT_SIZE (FUZZ_MAX_LENGTH + 16)
+
+#define FUZZ_RUNS 100000
+#define FUZZ_SEED 0x9E3779B9
+
+//the number of inputs that were encoded and decoded, the others were rejected by the encoder
+static unsigned long fuzz_encoded;
+
+static void fuzz_fail(BarcodeType type, const char* data, size_t length, const char* reason) {
+    const char* name = barcode_type_objs[type].name;
+    fprintf(stderr, "%s with %s data of %zu characters: ", reason, name, length);
+    for(size_t i = 0; i < length; i++) {
+        unsigned char character = data[i];
+        fprintf(stderr, character >= ' ' && character < 0x7F ? "%c" : "\\x%02X", character);
+    }
+    fputc('\n', stderr);
+    abort();
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* input, size_t size) {
+    if(size == 0 || size - 1 > FUZZ_MAX_LENGTH) {
+        return 0;
+    }
+    BarcodeType type = input[0] % UNKNOWN;
+    size_t length = size - 1;
+
+    //the loader passes the null terminated data of a FuriString
+    char data[FUZZ_MAX_LENGTH + 1];
+    memcpy(data, input + 1, length);
+    data[length] = '\0';
+
+    BarcodeAllocStats start;
+    barcode_alloc_get_stats(&start);
+
+    size_t encoded_size = barcode_encoded_size(type, data, length);
+    BarcodeScratch scratch = {.data = NULL, .size = barcode_scratch_size(type, length)};
+    if(scratch.size > 0) {
+        scratch.data = barcode_alloc(scratch.size);
+    }
+    ModuleBuffer* modules = module_buffer_alloc(encoded_size);
+    //a scratch one byte too small has to be rejected before the encoder writes to it
+    if(scratch.size > 0) {
+        BarcodeScratch small = {.data = scratch.data, .size = scratch.size - 1};
+        ErrorCode small_result = barcode_encode(type, data, length, modules, &small);
+        if(small_result == OKCode) {
+            fuzz_fail(type, data, length, "encoded with a scratch smaller than barcode_scratch_size");
+        }
+        module_buffer_reset(modules);
+    }
+    ErrorCode result = barcode_encode(type, data, length, modules, &scratch);
+    barcode_alloc_free(scratch.data);
+    if(result == ScratchTooSmall) {
+        fuzz_fail(type, data, length, "the scratch of barcode_scratch_size is too small");
+    }
+
+    if(result == OKCode) {
+        fuzz_encoded++;
+        if(module_buffer_size(modules) > encoded_size) {
+            fuzz_fail(type, data, length, "more modules than barcode_encoded_size");
+        }
+
+        char text[FUZZ_TEXT_SIZE];
+        char expected[FUZZ_TEXT_SIZE];
+        BarcodeDecodeResult decoded = barcode_decode(type, modules, text, sizeof(text));
+        if(decoded != BarcodeDecodeUnsupportedType) {
+            if(decoded != BarcodeDecodeOK) {
+                fuzz_fail(type, data, length, barcode_decode_result_name(decoded));
+            }
+            barcode_decode_expected(type, data, length, expected, sizeof(expected));
+            if(strcmp(text, expected) != 0) {
+                fuzz_fail(type, data, length, "the decoded text differs");
+            }
+        }
+    }
+    module_buffer_free(modules);
+
+    BarcodeAllocStats end;
+    barcode_alloc_get_stats(&end);
+    if(end.bytes_in_use != start.bytes_in_use ||
+       end.allocs - start.allocs != end.frees - start.frees) {
+        fuzz_fail(type, data, length, "leaked an allocation");
+    }
+    return 0;
+}
+
+#ifndef BARCODE_LIBFUZZER
+
+static uint32_t fuzz_random(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * Fills input with a random type and data, most characters are digits or printable so the inputs get
+ * past the validation of the encoders
+*/
+static size_t fuzz_random_input(uint32_t* state, uint8_t* input) {
+    input[0] = fuzz_random(state);
+    size_t length = fuzz_random(state) % 4 == 0 ? fuzz_random(state) % (FUZZ_MAX_LENGTH + 1) :
+                                                  fuzz_random(state) % 24;
+    uint32_t alphabet = fuzz_random(state) % 3;
+    for(size_t i = 1; i <= length; i++) {
+        uint32_t value = fuzz_random(state);
+        if(alphabet == 0 || value % 16 == 0) {
+            input[i] = value >> 8;
+        } else if(alphabet == 1) {
+            input[i] = '0' + (value >> 8) % 10;
+        } else {
+            input[i] = ' ' + (value >> 8) % 95;
+        }
+    }
+    return length + 1;
+}
+
+static int fuzz_file(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if(file == NULL) {
+        fprintf(stderr, "could not open %s\n", path);
+        return 1;
+    }
+    uint8_t input[FUZZ_MAX_LENGTH + 2];
+    size_t size = fread(input, 1, sizeof(input), file);
+    fclose(file);
+    LLVMFuzzerTestOneInput(input, size);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    unsigned long runs = FUZZ_RUNS;
+    uint32_t seed = FUZZ_SEED;
+    int files = 0;
+    int failed = 0;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = strtoul(argv[++i], NULL, 0);
+        } else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoul(argv[++i], NULL, 0);
+        } else {
+            failed |= fuzz_file(argv[i]);
+            files++;
+        }
+    }
+    if(files > 0) {
+        return failed;
+    }
+
+    uint32_t state = seed != 0 ? seed : FUZZ_SEED;
+    uint8_t input[FUZZ_MAX_LENGTH + 1];
+    for(unsigned long i = 0; i < runs; i++) {
+        LLVMFuzzerTestOneInput(input, fuzz_random_input(&state, input));
+    }
+    printf("%lu inputs, %lu encoded, seed 0x%08X\n", runs, fuzz_encoded, (unsigned)seed);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,139 @@
+/**
+ * Checks the bars of the golden barcodes of barcode_goldens.h against the PBM images in golden_bars
+ * The images are made by scripts/gen_goldens.py without the encoder, this lays the modules of the encoder
+ * out like the barcode view does and compares the bars byte for byte
+ * usage: golden [--folder FOLDER]
+ * @returns 1 if the bars of a golden barcode differ from its image
+*/
+
+#include "barcode_encoder.h"
+#include "barcode_goldens.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//the folder of the golden images, set by the Makefile
+#ifndef GOLDEN_FOLDER
+#define GOLDEN_FOLDER "../" BARCODE_GOLDEN_BARS
+#endif
+
+//the place of the bars on the screen, the same as barcode_app.h which needs the SDK
+#define GOLDEN_Y_START 3
+#define GOLDEN_HEIGHT 50
+#define GOLDEN_GUARD_HEIGHT (GOLDEN_HEIGHT + 5)
+
+#define GOLDEN_PBM_HEADER "P4\n128 64\n"
+#define GOLDEN_ROW_BYTES (128 / 8)
+#define GOLDEN_PBM_SIZE (sizeof(GOLDEN_PBM_HEADER) - 1 + GOLDEN_ROW_BYTES * 64)
+
+typedef struct {
+    const char* type;
+    const char* data;
+    const char* name;
+} Golden;
+
+static const Golden goldens[] = {
+#define GOLDEN(type, data, name) {type, data, name},
+    BARCODE_GOLDENS(GOLDEN)
+#undef GOLDEN
+};
+
+/**
+ * Draws the bars of a barcode into a PBM image of the screen
+ * @returns false if the barcode did not encode
+*/
+static bool golden_draw(const Golden* golden, uint8_t* pbm) {
+    const BarcodeTypeObj* type_obj = get_type_by_name(golden->type, strlen(golden->type));
+    size_t length = strlen(golden->data);
+
+    BarcodeScratch scratch = {.data = NULL, .size = barcode_scratch_size(type_obj->type, length)};
+    if(scratch.size > 0) {
+        scratch.data = malloc(scratch.size);
+    }
+    ModuleBuffer* modules = module_buffer_alloc(barcode_encoded_size(type_obj->type, golden->data, length));
+    ErrorCode result = barcode_encode(type_obj->type, golden->data, length, modules, &scratch);
+    free(scratch.data);
+
+    memset(pbm, 0, GOLDEN_PBM_SIZE);
+    memcpy(pbm, GOLDEN_PBM_HEADER, sizeof(GOLDEN_PBM_HEADER) - 1);
+    uint8_t* rows = pbm + sizeof(GOLDEN_PBM_HEADER) - 1;
+
+    //EAN/UPC types start at their start_pos, the others are centered like build_render does
+    int size = module_buffer_size(modules);
+    int x = type_obj->layout != NULL ? type_obj->start_pos : (128 - size) / 2;
+    for(int y = GOLDEN_Y_START; result == OKCode && y < GOLDEN_Y_START + GOLDEN_GUARD_HEIGHT; y++) {
+        for(int i = 0; i < size; i++) {
+            bool bar = module_buffer_get(modules, i) &&
+                       (y < GOLDEN_Y_START + GOLDEN_HEIGHT || module_buffer_is_guard(modules, i));
+            if(bar && x + i >= 0 && x + i < 128) {
+                rows[y * GOLDEN_ROW_BYTES + (x + i) / 8] |= 0x80 >> ((x + i) % 8);
+            }
+        }
+    }
+    module_buffer_free(modules);
+    return result == OKCode;
+}
+
+/**
+ * @returns false if the image could not be read or is not a PBM image of the screen
+*/
+static bool golden_read(const char* folder, const Golden* golden, uint8_t* pbm) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s.pbm", folder, golden->name);
+    FILE* file = fopen(path, "rb");
+    if(file == NULL) {
+        fprintf(stderr, "could not open %s\n", path);
+        return false;
+    }
+    size_t size = fread(pbm, 1, GOLDEN_PBM_SIZE + 1, file);
+    fclose(file);
+    if(size != GOLDEN_PBM_SIZE || memcmp(pbm, GOLDEN_PBM_HEADER, sizeof(GOLDEN_PBM_HEADER) - 1) != 0) {
+        fprintf(stderr, "%s is not a 128x64 PBM image\n", path);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* folder = GOLDEN_FOLDER;
+    if(argc == 3 && strcmp(argv[1], "--folder") == 0) {
+        folder = argv[2];
+    } else if(argc != 1) {
+        fprintf(stderr, "usage: %s [--folder FOLDER]\n", argv[0]);
+        return 2;
+    }
+
+    uint8_t expected[GOLDEN_PBM_SIZE + 1];
+    uint8_t drawn[GOLDEN_PBM_SIZE];
+    size_t failed = 0;
+    for(size_t i = 0; i < sizeof(goldens) / sizeof(goldens[0]); i++) {
+        const Golden* golden = &goldens[i];
+        if(!golden_read(folder, golden, expected)) {
+            failed++;
+            continue;
+        }
+        if(!golden_draw(golden, drawn)) {
+            fprintf(stderr, "%s %s did not encode\n", golden->type, golden->data);
+            failed++;
+            continue;
+        }
+        for(size_t j = sizeof(GOLDEN_PBM_HEADER) - 1; j < GOLDEN_PBM_SIZE; j++) {
+            if(drawn[j] != expected[j]) {
+                size_t offset = j - (sizeof(GOLDEN_PBM_HEADER) - 1);
+                fprintf(
+                    stderr,
+                    "%s %s: row %zu differs from %s.pbm at x %zu\n",
+                    golden->type,
+                    golden->data,
+                    offset / GOLDEN_ROW_BYTES,
+                    golden->name,
+                    offset % GOLDEN_ROW_BYTES * 8);
+                failed++;
+                break;
+            }
+        }
+    }
+    printf("%zu goldens, %zu failed\n", sizeof(goldens) / sizeof(goldens[0]), failed);
+    return failed > 0;
+}
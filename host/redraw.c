@@ -0,0 +1,188 @@
+/**
+ * Counts the redraws the create view asks for per key press, built with the SDK of sdk/
+ * A key press sends press, short and release to the view, together they should redraw it at most once,
+ * and not at all when they change nothing. Every commit of the model with update and every switch of
+ * views is a redraw, see host_sdk_redraws
+ * The keyboard is replaced by the text_input functions below, so its own redraws are not counted and its
+ * result is sent straight to the create view
+ * usage: redraw
+ * @returns 1 if a key press redraws more often than expected
+*/
+
+#define _GNU_SOURCE
+
+#include "barcode_app.h"
+#include "host_sdk.h"
+
+#include <ftw.h>
+#include <inttypes.h>
+
+#define REDRAW_FOLDER_TEMPLATE "/tmp/barcode_redraw.XXXXXX"
+
+/**
+ * The keyboard, it only keeps the result callback and the buffer of the create view
+*/
+struct TextInput {
+    View* view;
+    TextInputCallback callback;
+    void* callback_context;
+    char* text_buffer;
+    size_t text_buffer_size;
+};
+
+void text_input_set_result_callback(
+    TextInput* text_input,
+    TextInputCallback callback,
+    void* callback_context,
+    char* text_buffer,
+    size_t text_buffer_size,
+    bool clear_default_text) {
+    UNUSED(clear_default_text);
+    text_input->callback = callback;
+    text_input->callback_context = callback_context;
+    text_input->text_buffer = text_buffer;
+    text_input->text_buffer_size = text_buffer_size;
+}
+
+void text_input_set_header_text(TextInput* text_input, const char* text) {
+    UNUSED(text_input);
+    UNUSED(text);
+}
+
+void text_input_show_illegal_symbols(TextInput* text_input, bool show) {
+    UNUSED(text_input);
+    UNUSED(show);
+}
+
+typedef enum {
+    RedrawKey, //a press, short and release of the key of the step
+    RedrawText, //the keyboard returns the text of the step
+} RedrawAction;
+
+typedef struct {
+    const char* name;
+    RedrawAction action;
+    InputKey key;
+    const char* text;
+    uint32_t expected; //the redraws the step may ask for
+} RedrawStep;
+
+//a new CODE-39 barcode like traces/checkout.txt makes, the create view starts on the type
+static const RedrawStep steps[] = {
+    {"up at the top", RedrawKey, InputKeyUp, NULL, 0},
+    {"right on the type", RedrawKey, InputKeyRight, NULL, 1},
+    {"down to the file name", RedrawKey, InputKeyDown, NULL, 1},
+    {"up to the type", RedrawKey, InputKeyUp, NULL, 1},
+    {"down to the file name", RedrawKey, InputKeyDown, NULL, 1},
+    {"ok on the file name", RedrawKey, InputKeyOk, NULL, 1},
+    {"file name result", RedrawText, InputKeyMAX, "redraw", 1},
+    {"down to the data", RedrawKey, InputKeyDown, NULL, 1},
+    {"ok on the data", RedrawKey, InputKeyOk, NULL, 1},
+    {"data result", RedrawText, InputKeyMAX, "12345", 1},
+    {"down to save", RedrawKey, InputKeyDown, NULL, 1},
+    {"ok on save", RedrawKey, InputKeyOk, NULL, 1},
+};
+
+/**
+ * @returns the redraws of a step
+*/
+static uint32_t redraw_step(BarcodeApp* app, const RedrawStep* step) {
+    uint32_t redraws = host_sdk_redraws();
+    if(step->action == RedrawKey) {
+        static const InputType types[] = {InputTypePress, InputTypeShort, InputTypeRelease};
+        for(size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+            InputEvent event = {.key = step->key, .type = types[i]};
+            host_view_input(create_get_view(app->create_view), &event);
+        }
+    } else {
+        TextInput* text_input = app->text_input;
+        furi_check(text_input->callback != NULL);
+        strlcpy(text_input->text_buffer, step->text, text_input->text_buffer_size);
+        text_input->callback(text_input->callback_context);
+    }
+    return host_sdk_redraws() - redraws;
+}
+
+static int redraw_remove(const char* path, const struct stat* info, int flag, struct FTW* ftw) {
+    UNUSED(info);
+    UNUSED(flag);
+    UNUSED(ftw);
+    return remove(path);
+}
+
+int main(int argc, char** argv) {
+    if(argc != 1) {
+        fprintf(stderr, "usage: %s\n", argv[0]);
+        return 2;
+    }
+
+    //save writes the barcode to the SD card
+    char folder[] = REDRAW_FOLDER_TEMPLATE;
+    if(mkdtemp(folder) == NULL) {
+        fprintf(stderr, "could not make a folder for the SD card\n");
+        return 2;
+    }
+    host_sdk_set_storage(folder);
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_mkdir(storage, DEFAULT_USER_BARCODES);
+    furi_record_close(RECORD_STORAGE);
+    furi_log_set_level(FuriLogLevelWarn);
+
+    BarcodeApp app = {0};
+    TextInput text_input = {.view = view_alloc()};
+    View* main_menu = view_alloc();
+    app.text_input = &text_input;
+    app.view_dispatcher = view_dispatcher_alloc();
+    app.message_view = message_view_allocate(&app);
+    app.create_view = create_view_allocate(&app);
+    view_dispatcher_add_view(app.view_dispatcher, TextInputView, text_input.view);
+    view_dispatcher_add_view(app.view_dispatcher, MainMenuView, main_menu);
+    view_dispatcher_add_view(app.view_dispatcher, MessageErrorView, message_get_view(app.message_view));
+    view_dispatcher_add_view(app.view_dispatcher, CreateBarcodeView, create_get_view(app.create_view));
+
+    //the model of a new barcode, like the "Create Barcode" item of the main menu
+    with_view_model(
+        create_get_view(app.create_view),
+        CreateViewModel * model,
+        {
+            model->selected_menu_item = 0;
+            model->barcode_type = &barcode_type_objs[0];
+            model->file_path = furi_string_alloc();
+            model->file_name = furi_string_alloc();
+            model->barcode_data = furi_string_alloc();
+            model->mode = NewMode;
+        },
+        false);
+
+    size_t failed = 0;
+    for(size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        uint32_t redraws = redraw_step(&app, &steps[i]);
+        bool ok = redraws <= steps[i].expected;
+        printf("%-24s %" PRIu32 " redraws%s\n", steps[i].name, redraws, ok ? "" : ", too many");
+        failed += !ok;
+    }
+
+    //the barcode was saved with the name and the data of the steps
+    storage = furi_record_open(RECORD_STORAGE);
+    FileInfo file_info;
+    bool saved = storage_common_stat(storage, DEFAULT_USER_BARCODES "/redraw" BARCODE_EXTENSION, &file_info) ==
+                 FSE_OK;
+    furi_record_close(RECORD_STORAGE);
+    if(!saved) {
+        printf("the barcode was not saved\n");
+        failed++;
+    }
+
+    view_dispatcher_remove_view(app.view_dispatcher, CreateBarcodeView);
+    view_dispatcher_remove_view(app.view_dispatcher, MessageErrorView);
+    view_dispatcher_remove_view(app.view_dispatcher, MainMenuView);
+    view_dispatcher_remove_view(app.view_dispatcher, TextInputView);
+    create_view_free(app.create_view);
+    message_view_free(app.message_view);
+    view_dispatcher_free(app.view_dispatcher);
+    view_free(main_menu);
+    view_free(text_input.view);
+
+    nftw(folder, redraw_remove, 16, FTW_DEPTH | FTW_PHYS);
+    return failed > 0;
+}
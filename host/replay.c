@@ -0,0 +1,125 @@
+/**
+ * Replays an input trace through the whole app, built with the SDK of sdk/, like the "replay" app argument of
+ * debug builds does on a Flipper
+ * The app runs barcode_debug_replay_start itself: every key action goes through the view dispatcher, the
+ * submenu, the create view and the keyboard, and its latency is the time until the next frame
+ * The report is printed like replay.json, the latencies are the ones of the computer, not of a Flipper
+ * usage: replay [--keep] [TRACE]
+ * --keep keeps the folder of the SD card, the default trace is traces/checkout.txt
+ * @returns 1 if an input was not followed by a frame or the app did not write the report
+*/
+
+#define _GNU_SOURCE
+
+#include "barcode_app.h"
+#include "host_sdk.h"
+
+#include <ftw.h>
+
+//the trace that is replayed, set by the Makefile
+#ifndef REPLAY_TRACE
+#define REPLAY_TRACE "../traces/checkout.txt"
+#endif
+
+#define REPLAY_FOLDER_TEMPLATE "/tmp/barcode_replay.XXXXXX"
+
+int32_t barcode_main(void* p);
+
+/**
+ * Reads a file of the computer
+ * @returns the null terminated contents, NULL if the file could not be read
+*/
+static char* replay_read(FILE* file) {
+    if(file == NULL) {
+        return NULL;
+    }
+    size_t size = 0;
+    size_t capacity = 1024;
+    char* text = malloc(capacity);
+    for(size_t read; (read = fread(text + size, 1, capacity - size - 1, file)) > 0;) {
+        size += read;
+        if(size + 1 == capacity) {
+            capacity *= 2;
+            text = realloc(text, capacity);
+        }
+    }
+    fclose(file);
+    text[size] = '\0';
+    return text;
+}
+
+static int replay_remove(const char* path, const struct stat* info, int flag, struct FTW* ftw) {
+    UNUSED(info);
+    UNUSED(flag);
+    UNUSED(ftw);
+    return remove(path);
+}
+
+int main(int argc, char** argv) {
+    const char* trace_path = REPLAY_TRACE;
+    bool keep = false;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--keep") == 0) {
+            keep = true;
+        } else if(argv[i][0] != '-') {
+            trace_path = argv[i];
+        } else {
+            fprintf(stderr, "usage: %s [--keep] [TRACE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    char* trace = replay_read(fopen(trace_path, "rb"));
+    char folder[] = REPLAY_FOLDER_TEMPLATE;
+    if(trace == NULL || mkdtemp(folder) == NULL) {
+        fprintf(stderr, "could not read %s or make a folder for the SD card\n", trace_path);
+        free(trace);
+        return 2;
+    }
+    host_sdk_set_storage(folder);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_mkdir(storage, DEFAULT_USER_BARCODES);
+    File* file = storage_file_alloc(storage);
+    if(storage_file_open(file, BARCODE_REPLAY_TRACE, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        storage_file_write(file, trace, strlen(trace));
+    }
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    free(trace);
+
+    //warnings and errors only, the replay logs a line per flow that is printed below anyway
+    furi_log_set_level(FuriLogLevelWarn);
+    barcode_main(BARCODE_REPLAY_ARGS);
+
+    storage = furi_record_open(RECORD_STORAGE);
+    file = storage_file_alloc(storage);
+    char* report = NULL;
+    if(storage_file_open(file, BARCODE_REPLAY_REPORT, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        size_t size = storage_file_size(file);
+        report = malloc(size + 1);
+        report[storage_file_read(file, report, size)] = '\0';
+    }
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    size_t flows = 0;
+    size_t missed = 0;
+    for(const char* found = report; found != NULL && (found = strstr(found, "\"missed\":")) != NULL;
+        found++) {
+        missed += strtoul(found + 9, NULL, 10);
+        flows++;
+    }
+    if(report != NULL) {
+        fputs(report, stdout);
+    }
+    printf("%zu flows, %zu inputs without a frame\n", flows, missed);
+
+    if(keep) {
+        printf("the SD card is in %s\n", folder);
+    } else {
+        nftw(folder, replay_remove, 16, FTW_DEPTH | FTW_PHYS);
+    }
+    free(report);
+    return flows == 0 || missed > 0;
+}
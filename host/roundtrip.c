@@ -0,0 +1,678 @@
+/**
+ * Round trips random barcodes of every type through the encoding core on every core of a computer
+ * The modules are decoded by a reference decoder that only knows the tables of barcode_encoding_files and
+ * the EAN/UPC tables of the specification, so a mistake in the tables of encodings.c can't hide itself.
+ * They are also decoded by barcode_decoder.c, both have to read the text a scanner would read
+ * usage: roundtrip [--count N] [--threads N] [--seed N] [--max-length N] [--tables FOLDER]
+ * --count is the number of barcodes of every type, they are shared by the threads
+ * @returns 1 if a barcode did not round trip
+*/
+
+#include "barcode_decoder.h"
+#include "barcode_encoder.h"
+
+#include <ctype.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define ROUNDTRIP_COUNT 20000
+#define ROUNDTRIP_MAX_LENGTH 32
+#define ROUNDTRIP_SEED 0x2545F491
+
+//the most mismatches that are printed
+#define ROUNDTRIP_MAX_PRINTED 16
+
+//the decoded text has the check digits and delimiters on top of the data
+#define ROUNDTRIP_TEXT_SIZE(max_length) ((max_length) + 16)
+
+//the folder of the .txt tables, set by the Makefile
+#ifndef ROUNDTRIP_TABLES
+#define ROUNDTRIP_TABLES "../barcode_encoding_files"
+#endif
+
+//the Code 128 stop pattern isn't in code128_encodings.txt, this is the one of the specification
+#define CODE_128_STOP "1100011101011"
+#define CODE_128_CODEWORDS 106
+
+//the EAN/UPC tables of the specification, the R-codes are the L-codes inverted and the G-codes are the
+//R-codes reversed
+static const char* const EAN_L_CODES[10] = {
+    "0001101",
+    "0011001",
+    "0010011",
+    "0111101",
+    "0100011",
+    "0110001",
+    "0101111",
+    "0111011",
+    "0110111",
+    "0001011",
+};
+
+//the L/G parity of the six left digits of EAN-13 that encodes the first digit
+static const char* const EAN_13_PARITY[10] = {
+    "LLLLLL",
+    "LLGLGG",
+    "LLGGLG",
+    "LLGGGL",
+    "LGLLGG",
+    "LGGLLG",
+    "LGGGLL",
+    "LGLGLG",
+    "LGLGGL",
+    "LGGLGL",
+};
+
+/**
+ * The tables the reference decoder reads from barcode_encoding_files
+*/
+typedef struct {
+    char code_39[128][16]; //the wide (1) and narrow (0) elements of every character, empty if none
+    char codabar[128][16];
+    char code_128[CODE_128_CODEWORDS][16]; //the pattern of every codeword but the stop codeword
+    char code_128_b[CODE_128_CODEWORDS]; //the character of every codeword of set B, 0 if none
+} ReferenceTables;
+
+static ReferenceTables tables;
+
+typedef struct {
+    const BarcodeTypeObj* type_obj;
+    uint32_t seed;
+    size_t count;
+    size_t max_length;
+    size_t mismatches;
+} RoundtripJob;
+
+static pthread_mutex_t print_mutex = PTHREAD_MUTEX_INITIALIZER;
+static size_t printed;
+
+/**
+ * Reads a table file, every line is "key: value", lines that begin with "# " are comments and an empty
+ * line ends a section
+ * @param section  the index of the section that is read
+ * @param read  called with every key and value of the section
+ * @returns false if the file could not be read
+*/
+static bool read_table(
+    const char* folder,
+    const char* name,
+    int section,
+    void (*read)(const char* key, const char* value)) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", folder, name);
+    FILE* file = fopen(path, "r");
+    if(file == NULL) {
+        fprintf(stderr, "could not open %s\n", path);
+        return false;
+    }
+
+    char line[128];
+    int current = 0;
+    bool in_section = false;
+    while(fgets(line, sizeof(line), file) != NULL) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if(strncmp(line, "# ", 2) == 0) {
+            continue;
+        }
+        if(line[0] == '\0') {
+            current += in_section;
+            in_section = false;
+            continue;
+        }
+        in_section = true;
+
+        char* separator = strstr(line, ": ");
+        if(current != section || separator == NULL) {
+            continue;
+        }
+        *separator = '\0';
+        //the files write # as H# since # begins a comment in them
+        read(strcmp(line, "H#") == 0 ? "#" : line, separator + 2);
+    }
+    fclose(file);
+    return true;
+}
+
+static void read_code_39(const char* key, const char* value) {
+    snprintf(tables.code_39[(unsigned char)key[0] & 127], 16, "%s", value);
+}
+
+static void read_codabar(const char* key, const char* value) {
+    snprintf(tables.codabar[(unsigned char)key[0] & 127], 16, "%s", value);
+}
+
+static void read_code_128_b(const char* key, const char* value) {
+    int codeword = atoi(value);
+    if(codeword >= 0 && codeword < CODE_128_CODEWORDS) {
+        tables.code_128_b[codeword] = key[0];
+    }
+}
+
+static void read_code_128(const char* key, const char* value) {
+    //the section begins with its name
+    if(isdigit((unsigned char)key[0])) {
+        int codeword = atoi(key);
+        if(codeword >= 0 && codeword < CODE_128_CODEWORDS) {
+            snprintf(tables.code_128[codeword], 16, "%s", value);
+        }
+    }
+}
+
+static bool read_tables(const char* folder) {
+    return read_table(folder, "code39_encodings.txt", 0, read_code_39) &&
+           read_table(folder, "codabar_encodings.txt", 0, read_codabar) &&
+           read_table(folder, "code128_encodings.txt", 0, read_code_128_b) &&
+           read_table(folder, "code128_encodings.txt", 1, read_code_128);
+}
+
+/**
+ * The modules of a barcode as '0' and '1' characters, and where the reference decoder is in them
+*/
+typedef struct {
+    const char* modules;
+    size_t count;
+    size_t position;
+} Reader;
+
+static bool reader_take(Reader* reader, const char* pattern) {
+    size_t length = strlen(pattern);
+    if(reader->count - reader->position < length ||
+       strncmp(reader->modules + reader->position, pattern, length) != 0) {
+        return false;
+    }
+    reader->position += length;
+    return true;
+}
+
+/**
+ * @returns the digit of the 7 modules, and the code it was read as in code, or -1 if it is no digit
+*/
+static int reader_ean_digit(Reader* reader, char* code) {
+    if(reader->count - reader->position < 7) {
+        return -1;
+    }
+    const char* modules = reader->modules + reader->position;
+    reader->position += 7;
+    for(int digit = 0; digit < 10; digit++) {
+        const char* l_code = EAN_L_CODES[digit];
+        bool l = true, r = true, g = true;
+        for(int i = 0; i < 7; i++) {
+            l = l && modules[i] == l_code[i];
+            r = r && modules[i] != l_code[i];
+            g = g && modules[i] != l_code[6 - i];
+        }
+        if(l || r || g) {
+            *code = l ? 'L' : r ? 'R' : 'G';
+            return digit;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @returns the check digit of the specification, the digits are weighted 3 and 1 from the right
+*/
+static int ean_check_digit(const char* digits, size_t length) {
+    int sum = 0;
+    for(size_t i = 0; i < length; i++) {
+        sum += (digits[length - 1 - i] - '0') * (i % 2 == 0 ? 3 : 1);
+    }
+    return (10 - sum % 10) % 10;
+}
+
+static bool reference_ean_upc(BarcodeType type, Reader* reader, char* text) {
+    size_t left = type == EAN8 ? 4 : 6;
+    char* digits = type == EAN13 ? text + 1 : text;
+    char parity[7] = {0};
+    char code;
+
+    if(!reader_take(reader, "101")) {
+        return false;
+    }
+    for(size_t i = 0; i < left; i++) {
+        int digit = reader_ean_digit(reader, &code);
+        if(digit < 0 || code == 'R' || (type != EAN13 && code == 'G')) {
+            return false;
+        }
+        digits[i] = '0' + digit;
+        parity[i] = code;
+    }
+    if(!reader_take(reader, "01010")) {
+        return false;
+    }
+    for(size_t i = left; i < left * 2; i++) {
+        int digit = reader_ean_digit(reader, &code);
+        if(digit < 0 || code != 'R') {
+            return false;
+        }
+        digits[i] = '0' + digit;
+    }
+    if(!reader_take(reader, "101") || reader->position != reader->count) {
+        return false;
+    }
+
+    if(type == EAN13) {
+        int first = -1;
+        for(int i = 0; i < 10; i++) {
+            if(strcmp(parity, EAN_13_PARITY[i]) == 0) {
+                first = i;
+            }
+        }
+        if(first < 0) {
+            return false;
+        }
+        text[0] = '0' + first;
+    }
+    size_t length = left * 2 + (type == EAN13);
+    text[length] = '\0';
+    return ean_check_digit(text, length - 1) == text[length - 1] - '0';
+}
+
+/**
+ * Reads the next bar or space
+ * @returns the number of modules of the run, 0 at the end
+*/
+static size_t reader_run(Reader* reader) {
+    size_t start = reader->position;
+    while(reader->position < reader->count &&
+          reader->modules[reader->position] == reader->modules[start]) {
+        reader->position++;
+    }
+    return reader->position - start;
+}
+
+/**
+ * Reads Code 39 and Codabar, every character is a fixed number of bars and spaces that are wide or
+ * narrow, followed by a space between the characters that the last character may have too
+ * An element is wide if it is more than 1.5 times the narrowest element of its character, like a
+ * scanner that doesn't know the ratio the barcode was printed with
+*/
+static bool reference_wide_narrow(char table[128][16], Reader* reader, char* text, size_t size) {
+    size_t elements = strlen(table['0']);
+    size_t length = 0;
+    while(reader->position < reader->count) {
+        if(length > 0 && reader->modules[reader->position] == '0') {
+            reader_run(reader);
+            if(reader->position == reader->count) {
+                break;
+            }
+        }
+
+        size_t widths[16];
+        size_t narrow = SIZE_MAX;
+        for(size_t i = 0; i < elements; i++) {
+            bool bar = reader->position < reader->count && reader->modules[reader->position] == '1';
+            widths[i] = reader_run(reader);
+            if(widths[i] == 0 || bar != (i % 2 == 0)) {
+                return false;
+            }
+            narrow = widths[i] < narrow ? widths[i] : narrow;
+        }
+        char pattern[16];
+        for(size_t i = 0; i < elements; i++) {
+            pattern[i] = widths[i] * 2 > narrow * 3 ? '1' : '0';
+        }
+        pattern[elements] = '\0';
+
+        int character = 0;
+        while(character < 128 && strcmp(table[character], pattern) != 0) {
+            character++;
+        }
+        if(character == 128 || length + 1 >= size) {
+            return false;
+        }
+        text[length++] = character;
+    }
+    text[length] = '\0';
+    return length > 0;
+}
+
+static int reader_code_128_codeword(Reader* reader) {
+    for(int codeword = 0; codeword < CODE_128_CODEWORDS; codeword++) {
+        if(reader_take(reader, tables.code_128[codeword])) {
+            return codeword;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Reads Code 128 as the specification describes it, the codewords of set B come from the table file
+ * Set B has DEL at codeword 95, which isn't in the table file, set A has the ascii codes 32-95 at
+ * the codewords 0-63 and the control characters at 64-95 and set C has the digit pairs at 0-99
+*/
+static bool reference_code_128(Reader* reader, char* text, size_t size) {
+    int codewords[512];
+    size_t count = 0;
+    while(reader->count - reader->position > strlen(CODE_128_STOP)) {
+        int codeword = reader_code_128_codeword(reader);
+        if(codeword < 0 || count == sizeof(codewords) / sizeof(codewords[0])) {
+            return false;
+        }
+        codewords[count++] = codeword;
+    }
+    if(!reader_take(reader, CODE_128_STOP) || reader->position != reader->count || count < 2) {
+        return false;
+    }
+
+    //the start codeword counts once and every other codeword by its position
+    int sum = codewords[0];
+    for(size_t i = 1; i + 1 < count; i++) {
+        sum += codewords[i] * i;
+    }
+    if(sum % 103 != codewords[count - 1] || codewords[0] < 103) {
+        return false;
+    }
+
+    char set = 'A' + codewords[0] - 103;
+    size_t length = 0;
+    for(size_t i = 1; i + 1 < count; i++) {
+        int codeword = codewords[i];
+        char current = set;
+        if(codeword == 98 && set != 'C') {
+            //shift, only the next codeword is of the other set
+            if(++i + 1 >= count) {
+                return false;
+            }
+            codeword = codewords[i];
+            current = set == 'A' ? 'B' : 'A';
+        } else if((codeword == 99 && set != 'C') || codeword == 100 || codeword == 101) {
+            char code = codeword == 99 ? 'C' : codeword == 100 ? 'B' : 'A';
+            if(code == set) {
+                //FNC4, the app doesn't encode it
+                return false;
+            }
+            set = code;
+            continue;
+        } else if(codeword == 102 || codeword >= 103) {
+            return false;
+        }
+
+        if(length + 2 >= size) {
+            return false;
+        }
+        if(current == 'C') {
+            text[length++] = '0' + codeword / 10;
+            text[length++] = '0' + codeword % 10;
+        } else if(current == 'B') {
+            char character = codeword == 95 ? 0x7F : tables.code_128_b[codeword];
+            if(character == 0) {
+                return false;
+            }
+            text[length++] = character;
+        } else {
+            text[length++] = codeword < 64 ? codeword + 32 : codeword - 64;
+        }
+    }
+    text[length] = '\0';
+    return true;
+}
+
+/**
+ * Decodes the modules with the reference decoder
+ * @returns false if the modules are not a barcode of the type or the check doesn't match
+*/
+static bool
+    reference_decode(BarcodeType type, const char* modules, size_t count, char* text, size_t size) {
+    Reader reader = {.modules = modules, .count = count, .position = 0};
+    bool decoded = false;
+    switch(type) {
+    case UPCA:
+    case EAN8:
+    case EAN13:
+        decoded = size > 14 && reference_ean_upc(type, &reader, text);
+        break;
+    case CODE39:
+        decoded = reference_wide_narrow(tables.code_39, &reader, text, size);
+        break;
+    case CODABAR:
+        decoded = reference_wide_narrow(tables.codabar, &reader, text, size);
+        break;
+    case CODE128:
+    case CODE128C:
+        decoded = reference_code_128(&reader, text, size);
+        break;
+    default:
+        break;
+    }
+    if(!decoded) {
+        text[0] = '\0';
+    }
+    return decoded;
+}
+
+/**
+ * The text a scanner reads from the data, EAN/UPC get the check digit of the specification and Code 39
+ * is upper case between its delimiters
+*/
+static void roundtrip_expected(
+    const BarcodeTypeObj* type_obj,
+    const char* data,
+    size_t length,
+    char* text) {
+    if(type_obj->layout != NULL) {
+        size_t digits = type_obj->max_digits - 1;
+        memcpy(text, data, digits);
+        text[digits] = '0' + ean_check_digit(data, digits);
+        text[digits + 1] = '\0';
+    } else if(type_obj->type == CODE39) {
+        text[0] = '*';
+        for(size_t i = 0; i < length; i++) {
+            text[i + 1] = toupper((unsigned char)data[i]);
+        }
+        text[length + 1] = '*';
+        text[length + 2] = '\0';
+    } else {
+        memcpy(text, data, length + 1);
+    }
+}
+
+static uint32_t roundtrip_random(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/**
+ * Fills the data with random characters of the reference tables that are valid for the type
+ * @returns the length of the data
+*/
+static size_t roundtrip_payload(
+    const BarcodeTypeObj* type_obj,
+    uint32_t* state,
+    size_t max_length,
+    char* data) {
+    size_t length;
+    if(type_obj->max_digits > 0) {
+        //with and without the check digit
+        length = type_obj->max_digits - (roundtrip_random(state) & 1);
+    } else {
+        size_t lengths = max_length - type_obj->min_digits + 1;
+        length = type_obj->min_digits + roundtrip_random(state) % lengths;
+    }
+
+    char(*table)[16] = type_obj->type == CODE39  ? tables.code_39 :
+                       type_obj->type == CODABAR ? tables.codabar :
+                                                   NULL;
+    for(size_t i = 0; i < length; i++) {
+        if(table != NULL) {
+            //any character of the table but the delimiter, Code 39 in upper or lower case
+            int character;
+            do {
+                character = roundtrip_random(state) % 128;
+            } while(table[character][0] == '\0' || character == type_obj->delimiter);
+            bool lower = type_obj->type == CODE39 && roundtrip_random(state) & 1;
+            data[i] = lower ? tolower(character) : character;
+        } else if(type_obj->type == CODE128) {
+            //every ascii character but the null terminator
+            data[i] = 1 + roundtrip_random(state) % 127;
+        } else {
+            data[i] = '0' + roundtrip_random(state) % 10;
+        }
+    }
+    data[length] = '\0';
+    return length;
+}
+
+static void roundtrip_mismatch(
+    const BarcodeTypeObj* type_obj,
+    const char* data,
+    const char* decoder,
+    const char* text,
+    const char* expected) {
+    pthread_mutex_lock(&print_mutex);
+    if(printed++ < ROUNDTRIP_MAX_PRINTED) {
+        fprintf(stderr, "%s \"", type_obj->name);
+        for(const char* character = data; *character != '\0'; character++) {
+            fprintf(stderr, isprint((unsigned char)*character) ? "%c" : "\\x%02X", *character);
+        }
+        fprintf(stderr, "\": %s decoded \"%s\", expected \"%s\"\n", decoder, text, expected);
+    }
+    pthread_mutex_unlock(&print_mutex);
+}
+
+static void* roundtrip_thread(void* context) {
+    RoundtripJob* job = context;
+    const BarcodeTypeObj* type_obj = job->type_obj;
+    BarcodeType type = type_obj->type;
+    uint32_t state = job->seed;
+
+    size_t text_size = ROUNDTRIP_TEXT_SIZE(job->max_length);
+    char* data = malloc(job->max_length + 1);
+    char* expected = malloc(text_size);
+    char* text = malloc(text_size);
+
+    for(size_t i = 0; i < job->count; i++) {
+        size_t length = roundtrip_payload(type_obj, &state, job->max_length, data);
+        roundtrip_expected(type_obj, data, length, expected);
+
+        //the buffers are allocated at their exact size like barcode_loader does
+        size_t size = barcode_encoded_size(type, data, length);
+        ModuleBuffer* modules = module_buffer_alloc(size);
+        char* bits = malloc(size + 1);
+        BarcodeScratch scratch = {.size = barcode_scratch_size(type, length)};
+        scratch.data = malloc(scratch.size);
+
+        ErrorCode encoded = barcode_encode(type, data, length, modules, &scratch);
+        size_t count = encoded == OKCode ? module_buffer_size(modules) : 0;
+        for(size_t j = 0; j < count; j++) {
+            bits[j] = module_buffer_get(modules, j) ? '1' : '0';
+        }
+        bits[count] = '\0';
+
+        bool ok = encoded == OKCode;
+        if(!ok) {
+            roundtrip_mismatch(type_obj, data, "nothing, the encoder rejected it,", "", expected);
+        } else {
+            bool decoded = reference_decode(type, bits, count, text, text_size);
+            if(!decoded || strcmp(text, expected) != 0) {
+                roundtrip_mismatch(type_obj, data, "the reference decoder", text, expected);
+                ok = false;
+            }
+
+            BarcodeDecodeResult result = barcode_decode(type, modules, text, text_size);
+            if(result != BarcodeDecodeOK || strcmp(text, expected) != 0) {
+                char decoder[64];
+                const char* name = barcode_decode_result_name(result);
+                snprintf(decoder, sizeof(decoder), "barcode_decode (%s)", name);
+                roundtrip_mismatch(type_obj, data, decoder, text, expected);
+                ok = false;
+            }
+        }
+        job->mismatches += !ok;
+
+        free(scratch.data);
+        free(bits);
+        module_buffer_free(modules);
+    }
+
+    free(text);
+    free(expected);
+    free(data);
+    return NULL;
+}
+
+static uint64_t host_clock_ns() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+int main(int argc, char** argv) {
+    size_t count = ROUNDTRIP_COUNT;
+    size_t max_length = ROUNDTRIP_MAX_LENGTH;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t seed = ROUNDTRIP_SEED;
+    const char* folder = ROUNDTRIP_TABLES;
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            count = strtoul(argv[++i], NULL, 0);
+        } else if(strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = strtol(argv[++i], NULL, 0);
+        } else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoul(argv[++i], NULL, 0);
+        } else if(strcmp(argv[i], "--max-length") == 0 && i + 1 < argc) {
+            max_length = strtoul(argv[++i], NULL, 0);
+        } else if(strcmp(argv[i], "--tables") == 0 && i + 1 < argc) {
+            folder = argv[++i];
+        } else {
+            fprintf(
+                stderr,
+                "usage: %s [--count N] [--threads N] [--seed N] [--max-length N] "
+                "[--tables FOLDER]\n",
+                argv[0]);
+            return 2;
+        }
+    }
+    if(threads < 1) {
+        threads = 1;
+    }
+    if(max_length < 2 || seed == 0 || !read_tables(folder)) {
+        fprintf(stderr, "the max length has to be at least 2 and the seed can't be 0\n");
+        return 2;
+    }
+
+    pthread_t* thread_ids = malloc(sizeof(pthread_t) * threads);
+    RoundtripJob* jobs = malloc(sizeof(RoundtripJob) * threads);
+    size_t mismatches = 0;
+    for(int i = 0; i < UNKNOWN; i++) {
+        uint64_t start = host_clock_ns();
+        for(long j = 0; j < threads; j++) {
+            jobs[j] = (RoundtripJob){
+                .type_obj = &barcode_type_objs[i],
+                .seed = seed + (uint32_t)(i * threads + j) * 0x9E3779B9,
+                .count = count / threads + ((size_t)j < count % threads),
+                .max_length = max_length,
+                .mismatches = 0,
+            };
+            if(jobs[j].seed == 0) {
+                jobs[j].seed = ROUNDTRIP_SEED;
+            }
+            pthread_create(&thread_ids[j], NULL, roundtrip_thread, &jobs[j]);
+        }
+
+        size_t type_mismatches = 0;
+        for(long j = 0; j < threads; j++) {
+            pthread_join(thread_ids[j], NULL);
+            type_mismatches += jobs[j].mismatches;
+        }
+        uint64_t elapsed = host_clock_ns() - start;
+        printf(
+            "%-10s %zu barcodes, %zu mismatches, %llu barcodes/s\n",
+            barcode_type_objs[i].name,
+            count,
+            type_mismatches,
+            elapsed > 0 ? (unsigned long long)(count * 1000000000ull / elapsed) : 0);
+        mismatches += type_mismatches;
+    }
+
+    free(jobs);
+    free(thread_ids);
+    return mismatches > 0 ? 1 : 0;
+}
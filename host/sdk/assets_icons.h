@@ -0,0 +1,3 @@
+#pragma once
+
+//the icons of the firmware, the app only uses its own icons that sdk.c defines
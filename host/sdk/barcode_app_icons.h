@@ -0,0 +1,6 @@
+#pragma once
+
+#include <gui/canvas.h>
+
+//fbt generates this header from the images of the app, sdk.c defines the icons
+extern const Icon I_barcode_10;
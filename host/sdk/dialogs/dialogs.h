@@ -0,0 +1,25 @@
+#pragma once
+
+#include <gui/canvas.h>
+
+//the file browser selects the first file of the folder in alphabetical order without asking
+typedef struct DialogsApp DialogsApp;
+
+typedef struct {
+    const char* extension;
+    const char* base_path;
+    bool skip_assets;
+    bool hide_dot_files;
+    const Icon* icon;
+    bool hide_ext;
+} DialogsFileBrowserOptions;
+
+void dialog_file_browser_set_basic_options(
+    DialogsFileBrowserOptions* options,
+    const char* extension,
+    const Icon* icon);
+bool dialog_file_browser_show(
+    DialogsApp* context,
+    FuriString* result_path,
+    FuriString* path,
+    const DialogsFileBrowserOptions* options);
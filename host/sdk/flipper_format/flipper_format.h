@@ -0,0 +1,19 @@
+#pragma once
+
+#include <storage/storage.h>
+
+//the files are "Key: value" lines, a key is searched for from the line after the last one that was read
+typedef struct FlipperFormat FlipperFormat;
+
+FlipperFormat* flipper_format_file_alloc(Storage* storage);
+void flipper_format_free(FlipperFormat* flipper_format);
+bool flipper_format_file_open_existing(FlipperFormat* flipper_format, const char* path);
+bool flipper_format_file_open_new(FlipperFormat* flipper_format, const char* path);
+bool flipper_format_file_open_always(FlipperFormat* flipper_format, const char* path);
+bool flipper_format_rewind(FlipperFormat* flipper_format);
+bool flipper_format_read_string(FlipperFormat* flipper_format, const char* key, FuriString* data);
+bool flipper_format_write_string_cstr(
+    FlipperFormat* flipper_format,
+    const char* key,
+    const char* data);
+bool flipper_format_write_comment_cstr(FlipperFormat* flipper_format, const char* data);
@@ -0,0 +1,189 @@
+#pragma once
+
+/**
+ * The parts of the Flipper SDK the app uses, implemented on a computer by sdk.c so the views and the app
+ * can be run by the host drivers
+ * Only the behaviour the app depends on is implemented, see host_sdk.h for what the drivers control
+*/
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UNUSED(x) (void)(x)
+#define COUNT_OF(x) (sizeof(x) / sizeof(x[0]))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define CLAMP(x, upper, lower) (MIN(upper, MAX(x, lower)))
+
+//furi_crash takes an optional message
+void host_crash(const char* const* message);
+#define furi_crash(...) host_crash((const char*[2]){__VA_ARGS__})
+#define furi_check(x) ((x) ? (void)0 : furi_crash("furi_check failed: " #x))
+#define furi_assert(x) furi_check(x)
+
+//the log lines are written to stderr when the level is at least FuriLogLevelInfo
+typedef enum {
+    FuriLogLevelDefault = 0,
+    FuriLogLevelNone = 1,
+    FuriLogLevelError = 2,
+    FuriLogLevelWarn = 3,
+    FuriLogLevelInfo = 4,
+    FuriLogLevelDebug = 5,
+    FuriLogLevelTrace = 6,
+} FuriLogLevel;
+
+FuriLogLevel furi_log_get_level(void);
+void furi_log_set_level(FuriLogLevel level);
+void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+#define FURI_LOG_E(tag, format, ...) furi_log_print_format(FuriLogLevelError, tag, format, ##__VA_ARGS__)
+#define FURI_LOG_W(tag, format, ...) furi_log_print_format(FuriLogLevelWarn, tag, format, ##__VA_ARGS__)
+#define FURI_LOG_I(tag, format, ...) furi_log_print_format(FuriLogLevelInfo, tag, format, ##__VA_ARGS__)
+#define FURI_LOG_D(tag, format, ...) furi_log_print_format(FuriLogLevelDebug, tag, format, ##__VA_ARGS__)
+#define FURI_LOG_T(tag, format, ...) furi_log_print_format(FuriLogLevelTrace, tag, format, ##__VA_ARGS__)
+
+//the critical sections of the app only guard counters, one lock for all of them is enough on a computer
+void furi_critical_enter(void);
+void furi_critical_exit(void);
+#define FURI_CRITICAL_ENTER() furi_critical_enter()
+#define FURI_CRITICAL_EXIT() furi_critical_exit()
+
+//the C library of the firmware has these, older C libraries of computers don't
+size_t strlcpy(char* destination, const char* source, size_t size);
+size_t strlcat(char* destination, const char* source, size_t size);
+
+#define EXT_PATH(path) "/ext/" path
+
+#define RECORD_STORAGE "storage"
+#define RECORD_GUI "gui"
+#define RECORD_DIALOGS "dialogs"
+#define RECORD_NOTIFICATION "notification"
+#define RECORD_INPUT_EVENTS "input_events"
+
+void* furi_record_open(const char* name);
+void furi_record_close(const char* name);
+
+typedef enum {
+    FuriStatusOk = 0,
+    FuriStatusError = -1,
+    FuriStatusErrorTimeout = -2,
+} FuriStatus;
+
+#define FuriWaitForever 0xFFFFFFFFU
+
+uint32_t furi_get_tick(void);
+uint32_t furi_kernel_get_tick_frequency(void);
+void furi_delay_ms(uint32_t milliseconds);
+void furi_delay_us(uint32_t microseconds);
+
+#define FURI_STRING_FAILURE ((size_t)-1)
+
+typedef struct FuriString FuriString;
+
+FuriString* furi_string_alloc(void);
+FuriString* furi_string_alloc_set_str(const char* text);
+FuriString* furi_string_alloc_printf(const char* format, ...) __attribute__((format(printf, 1, 2)));
+void furi_string_free(FuriString* string);
+void furi_string_set_str(FuriString* string, const char* text);
+void furi_string_set_strn(FuriString* string, const char* text, size_t length);
+void furi_string_reset(FuriString* string);
+size_t furi_string_size(const FuriString* string);
+char furi_string_get_char(const FuriString* string, size_t index);
+void furi_string_set_char(FuriString* string, size_t index, char character);
+const char* furi_string_get_cstr(const FuriString* string);
+void furi_string_cat_str(FuriString* string, const char* text);
+void furi_string_push_back(FuriString* string, char character);
+int furi_string_printf(FuriString* string, const char* format, ...)
+    __attribute__((format(printf, 2, 3)));
+int furi_string_cat_printf(FuriString* string, const char* format, ...)
+    __attribute__((format(printf, 2, 3)));
+void furi_string_replace_at(FuriString* string, size_t index, size_t length, const char* text);
+bool furi_string_empty(const FuriString* string);
+bool furi_string_equal_str(const FuriString* string, const char* text);
+size_t furi_string_search_rchar(const FuriString* string, char character, size_t start);
+void furi_string_left(FuriString* string, size_t index);
+void furi_string_right(FuriString* string, size_t index);
+
+//the SDK takes a FuriString or a C string for these
+#define furi_string_alloc_set(source)                \
+    _Generic(                                        \
+        (source),                                    \
+        char*: furi_string_alloc_set_str,            \
+        const char*: furi_string_alloc_set_str,      \
+        default: furi_string_alloc_set_string)(source)
+#define furi_string_set(string, source)        \
+    _Generic(                                  \
+        (source),                              \
+        char*: furi_string_set_str,            \
+        const char*: furi_string_set_str,      \
+        default: furi_string_set_string)(string, source)
+#define furi_string_cat(string, source)        \
+    _Generic(                                  \
+        (source),                              \
+        char*: furi_string_cat_str,            \
+        const char*: furi_string_cat_str,      \
+        default: furi_string_cat_string)(string, source)
+#define furi_string_equal(string, other)        \
+    _Generic(                                   \
+        (other),                                \
+        char*: furi_string_equal_str,           \
+        const char*: furi_string_equal_str,     \
+        default: furi_string_equal_string)(string, other)
+
+FuriString* furi_string_alloc_set_string(const FuriString* source);
+void furi_string_set_string(FuriString* string, const FuriString* source);
+void furi_string_cat_string(FuriString* string, const FuriString* source);
+bool furi_string_equal_string(const FuriString* string, const FuriString* other);
+
+typedef struct FuriMessageQueue FuriMessageQueue;
+
+FuriMessageQueue* furi_message_queue_alloc(uint32_t count, uint32_t message_size);
+void furi_message_queue_free(FuriMessageQueue* queue);
+
+typedef struct FuriSemaphore FuriSemaphore;
+
+FuriSemaphore* furi_semaphore_alloc(uint32_t max_count, uint32_t initial_count);
+void furi_semaphore_free(FuriSemaphore* semaphore);
+FuriStatus furi_semaphore_acquire(FuriSemaphore* semaphore, uint32_t timeout);
+FuriStatus furi_semaphore_release(FuriSemaphore* semaphore);
+
+typedef struct FuriThread FuriThread;
+typedef void* FuriThreadId;
+typedef int32_t (*FuriThreadCallback)(void* context);
+
+FuriThread* furi_thread_alloc_ex(
+    const char* name,
+    uint32_t stack_size,
+    FuriThreadCallback callback,
+    void* context);
+void furi_thread_free(FuriThread* thread);
+void furi_thread_start(FuriThread* thread);
+bool furi_thread_join(FuriThread* thread);
+FuriThreadId furi_thread_get_current_id(void);
+uint32_t furi_thread_get_stack_space(FuriThreadId thread_id);
+
+//the timers never fire, the app only uses one to blink the cursor of the keyboard
+typedef struct FuriTimer FuriTimer;
+typedef void (*FuriTimerCallback)(void* context);
+typedef enum {
+    FuriTimerTypeOnce,
+    FuriTimerTypePeriodic,
+} FuriTimerType;
+
+FuriTimer* furi_timer_alloc(FuriTimerCallback callback, FuriTimerType type, void* context);
+void furi_timer_free(FuriTimer* timer);
+FuriStatus furi_timer_start(FuriTimer* timer, uint32_t ticks);
+FuriStatus furi_timer_stop(FuriTimer* timer);
+
+typedef struct FuriPubSub FuriPubSub;
+
+void furi_pubsub_publish(FuriPubSub* pubsub, void* message);
+
+size_t memmgr_get_free_heap(void);
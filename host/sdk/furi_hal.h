@@ -0,0 +1,22 @@
+#pragma once
+
+#include <furi.h>
+
+//the cycle counter counts at the clock of the Flipper, 64 MHz, reading DWT updates it from the host clock
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+DWT_Type* host_dwt(void);
+extern CoreDebug_Type* CoreDebug;
+
+#define DWT (host_dwt())
+#define DWT_CTRL_CYCCNTENA_Msk 1
+#define CoreDebug_DEMCR_TRCENA_Msk (1 << 24)
+
+uint32_t furi_hal_cortex_instructions_per_microsecond(void);
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <furi.h>
+
+//the canvas is a 128x64 frame buffer, the text functions draw nothing since there are no fonts
+//every call of a view is counted, see host_sdk.h
+typedef struct Canvas Canvas;
+
+typedef enum {
+    ColorWhite = 0,
+    ColorBlack = 1,
+    ColorXOR = 2,
+} Color;
+
+typedef enum {
+    FontPrimary,
+    FontSecondary,
+    FontKeyboard,
+    FontBigNumbers,
+    FontBatteryPercent,
+} Font;
+
+typedef enum {
+    AlignLeft,
+    AlignRight,
+    AlignTop,
+    AlignBottom,
+    AlignCenter,
+} Align;
+
+typedef struct Icon Icon;
+
+void canvas_clear(Canvas* canvas);
+size_t canvas_width(const Canvas* canvas);
+size_t canvas_height(const Canvas* canvas);
+uint8_t* canvas_get_buffer(Canvas* canvas);
+void canvas_set_color(Canvas* canvas, Color color);
+void canvas_set_font(Canvas* canvas, Font font);
+uint16_t canvas_string_width(Canvas* canvas, const char* text);
+uint8_t canvas_current_font_height(const Canvas* canvas);
+void canvas_draw_dot(Canvas* canvas, int32_t x, int32_t y);
+void canvas_draw_box(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height);
+void canvas_draw_frame(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height);
+void canvas_draw_rframe(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    size_t radius);
+void canvas_draw_xbm(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap);
+void canvas_draw_icon(Canvas* canvas, int32_t x, int32_t y, const Icon* icon);
+void canvas_draw_glyph(Canvas* canvas, int32_t x, int32_t y, uint16_t character);
+void canvas_draw_str(Canvas* canvas, int32_t x, int32_t y, const char* text);
+void canvas_draw_str_aligned(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    Align horizontal,
+    Align vertical,
+    const char* text);
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <gui/view.h>
+
+typedef struct Gui Gui;
+
+typedef enum {
+    CanvasOrientationHorizontal,
+} CanvasOrientation;
+
+typedef void (*GuiCanvasCommitCallback)(
+    uint8_t* data,
+    size_t size,
+    CanvasOrientation orientation,
+    void* context);
+
+//the frame buffer callbacks are called on the thread of the view dispatcher after every frame
+void gui_add_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback, void* context);
+void gui_remove_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback, void* context);
+Canvas* gui_direct_draw_acquire(Gui* gui);
+void gui_direct_draw_release(Gui* gui);
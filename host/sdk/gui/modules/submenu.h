@@ -0,0 +1,17 @@
+#pragma once
+
+#include <gui/view.h>
+
+//up and down move the selection and wrap around, ok calls the callback of the selected item
+typedef struct Submenu Submenu;
+typedef void (*SubmenuItemCallback)(void* context, uint32_t index);
+
+Submenu* submenu_alloc(void);
+void submenu_free(Submenu* submenu);
+View* submenu_get_view(Submenu* submenu);
+void submenu_add_item(
+    Submenu* submenu,
+    const char* label,
+    uint32_t index,
+    SubmenuItemCallback callback,
+    void* context);
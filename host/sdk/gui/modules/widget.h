@@ -0,0 +1,17 @@
+#pragma once
+
+#include <gui/view.h>
+
+typedef struct Widget Widget;
+
+Widget* widget_alloc(void);
+void widget_free(Widget* widget);
+void widget_reset(Widget* widget);
+View* widget_get_view(Widget* widget);
+void widget_add_text_scroll_element(
+    Widget* widget,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height,
+    const char* text);
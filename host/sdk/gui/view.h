@@ -0,0 +1,37 @@
+#pragma once
+
+#include <gui/canvas.h>
+#include <input/input.h>
+
+typedef struct View View;
+
+typedef void (*ViewDrawCallback)(Canvas* canvas, void* model);
+typedef bool (*ViewInputCallback)(InputEvent* event, void* context);
+typedef uint32_t (*ViewNavigationCallback)(void* context);
+
+typedef enum {
+    ViewModelTypeNone,
+    ViewModelTypeLockFree,
+    ViewModelTypeLocking,
+} ViewModelType;
+
+#define VIEW_NONE 0xFFFFFFFF
+
+View* view_alloc(void);
+void view_free(View* view);
+void view_set_context(View* view, void* context);
+void view_allocate_model(View* view, ViewModelType type, size_t size);
+void view_set_draw_callback(View* view, ViewDrawCallback callback);
+void view_set_input_callback(View* view, ViewInputCallback callback);
+void view_set_previous_callback(View* view, ViewNavigationCallback callback);
+
+//a locking model is locked from view_get_model until view_commit_model, update asks for a redraw
+void* view_get_model(View* view);
+void view_commit_model(View* view, bool update);
+
+#define with_view_model(view, type, code, update) \
+    {                                             \
+        type = view_get_model(view);              \
+        {code};                                   \
+        view_commit_model(view, update);          \
+    }
@@ -0,0 +1,62 @@
+#pragma once
+
+/**
+ * What the host drivers control of the SDK of sdk.c
+*/
+
+#include <gui/view.h>
+
+/**
+ * Sets the folder of the computer the SD card is in, /ext/apps_data is folder/apps_data
+ * The default is the working directory
+*/
+void host_sdk_set_storage(const char* folder);
+
+/**
+ * @returns the redraws the views asked for so far: every view_commit_model with update and every
+ * view_dispatcher_switch_to_view
+*/
+uint32_t host_sdk_redraws(void);
+
+/**
+ * Draws a view into a canvas like the GUI draws a frame, the canvas is cleared before the view draws
+*/
+void host_view_draw(View* view, Canvas* canvas);
+
+/**
+ * The canvas and elements functions the views call, every call a view makes is counted
+ * The calls the functions make to each other and the clear of the GUI before a frame are not counted
+*/
+typedef enum {
+    HostCanvasClear,
+    HostCanvasSetColor,
+    HostCanvasSetFont,
+    HostCanvasStringWidth,
+    HostCanvasDrawDot,
+    HostCanvasDrawBox,
+    HostCanvasDrawFrame,
+    HostCanvasDrawRFrame,
+    HostCanvasDrawXbm,
+    HostCanvasDrawIcon,
+    HostCanvasDrawGlyph,
+    HostCanvasDrawStr,
+    HostCanvasDrawStrAligned,
+    HostCanvasMultilineText,
+    HostCanvasMultilineTextAligned,
+    HostCanvasRoundedBox,
+    HostCanvasRoundedFrame,
+
+    HostCanvasCallCount
+} HostCanvasCall;
+
+/**
+ * @returns the calls of a canvas function since host_sdk_reset_canvas_calls
+*/
+uint32_t host_sdk_canvas_calls(HostCanvasCall call);
+void host_sdk_reset_canvas_calls(void);
+
+/**
+ * Sends an input straight to the input callback of a view, without a view dispatcher
+ * @returns true if the view handled the input
+*/
+bool host_view_input(View* view, InputEvent* event);
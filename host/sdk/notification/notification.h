@@ -0,0 +1,9 @@
+#pragma once
+
+#include <furi.h>
+
+typedef struct NotificationApp NotificationApp;
+typedef struct NotificationSequence NotificationSequence;
+
+void notification_message(NotificationApp* app, const NotificationSequence* sequence);
+void notification_message_block(NotificationApp* app, const NotificationSequence* sequence);
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <notification/notification.h>
+
+struct NotificationApp {
+    struct {
+        float display_brightness;
+    } settings;
+};
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <notification/notification.h>
+
+extern const NotificationSequence sequence_display_backlight_on;
+extern const NotificationSequence sequence_display_backlight_enforce_on;
+extern const NotificationSequence sequence_display_backlight_enforce_auto;
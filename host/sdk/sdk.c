@@ -0,0 +1,1624 @@
+/**
+ * The parts of the Flipper SDK the app uses, on a computer
+ * The view dispatcher runs like the one of the firmware: the inputs published to RECORD_INPUT_EVENTS and
+ * the custom events are handled one at a time on the thread that runs it, and a frame of the current view
+ * is drawn after every event that asked for a redraw, then the frame buffer callbacks of the GUI are called
+ * Threads, semaphores and the model locks are pthreads, the SD card is a folder of the computer
+*/
+
+#define _GNU_SOURCE
+
+#include "host_sdk.h"
+
+#include <furi_hal.h>
+#include <gui/elements.h>
+#include <gui/view_dispatcher.h>
+#include <gui/modules/submenu.h>
+#include <gui/modules/widget.h>
+#include <dialogs/dialogs.h>
+#include <flipper_format/flipper_format.h>
+#include <notification/notification_app.h>
+#include <notification/notification_messages.h>
+
+#include <dirent.h>
+#include <errno.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define HOST_PATH_SIZE 512
+
+//the most views of a view dispatcher and events that wait to be handled
+#define HOST_MAX_VIEWS 32
+#define HOST_QUEUE_SIZE 64
+
+#define HOST_MAX_SUBMENU_ITEMS 16
+#define HOST_MAX_FRAMEBUFFER_CALLBACKS 4
+
+/**
+ * Crash & log
+*/
+
+void host_crash(const char* const* message) {
+    fprintf(stderr, "furi_crash: %s\n", message[0] != NULL ? message[0] : "");
+    abort();
+}
+
+size_t strlcpy(char* destination, const char* source, size_t size) {
+    size_t length = strlen(source);
+    if(size > 0) {
+        size_t copied = MIN(length, size - 1);
+        memcpy(destination, source, copied);
+        destination[copied] = '\0';
+    }
+    return length;
+}
+
+size_t strlcat(char* destination, const char* source, size_t size) {
+    size_t length = strnlen(destination, size);
+    return length == size ? size + strlen(source) :
+                            length + strlcpy(destination + length, source, size - length);
+}
+
+static FuriLogLevel log_level = FuriLogLevelInfo;
+
+FuriLogLevel furi_log_get_level(void) {
+    return log_level;
+}
+
+void furi_log_set_level(FuriLogLevel level) {
+    log_level = level == FuriLogLevelDefault ? FuriLogLevelInfo : level;
+}
+
+void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
+    if(level > log_level) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "[%s] ", tag);
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+static pthread_mutex_t critical_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+void furi_critical_enter(void) {
+    pthread_mutex_lock(&critical_mutex);
+}
+
+void furi_critical_exit(void) {
+    pthread_mutex_unlock(&critical_mutex);
+}
+
+/**
+ * Time
+*/
+
+static uint64_t host_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+//the deadline of a wait of ticks, ticks are milliseconds
+static struct timespec host_deadline(uint32_t ticks) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    uint64_t ns = deadline.tv_nsec + (uint64_t)ticks * 1000000;
+    deadline.tv_sec += ns / 1000000000;
+    deadline.tv_nsec = ns % 1000000000;
+    return deadline;
+}
+
+uint32_t furi_get_tick(void) {
+    return host_now_ns() / 1000000;
+}
+
+uint32_t furi_kernel_get_tick_frequency(void) {
+    return 1000;
+}
+
+void furi_delay_ms(uint32_t milliseconds) {
+    furi_delay_us(milliseconds * 1000);
+}
+
+void furi_delay_us(uint32_t microseconds) {
+    struct timespec delay = {
+        .tv_sec = microseconds / 1000000, .tv_nsec = (microseconds % 1000000) * 1000};
+    nanosleep(&delay, NULL);
+}
+
+static DWT_Type dwt;
+static CoreDebug_Type core_debug;
+CoreDebug_Type* CoreDebug = &core_debug;
+
+DWT_Type* host_dwt(void) {
+    dwt.CYCCNT = (uint32_t)(host_now_ns() * 64 / 1000);
+    return &dwt;
+}
+
+uint32_t furi_hal_cortex_instructions_per_microsecond(void) {
+    return 64;
+}
+
+//the heap of the computer is larger than the one of a Flipper, only the changes of the free heap are used
+#define HOST_HEAP_SIZE (64 * 1024 * 1024)
+
+size_t memmgr_get_free_heap(void) {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks < HOST_HEAP_SIZE ? HOST_HEAP_SIZE - info.uordblks : 0;
+}
+
+/**
+ * FuriString
+*/
+
+struct FuriString {
+    char* text;
+    size_t size;
+    size_t capacity;
+};
+
+static void string_reserve(FuriString* string, size_t size) {
+    if(size + 1 > string->capacity) {
+        string->capacity = (size + 1) * 2;
+        string->text = realloc(string->text, string->capacity);
+    }
+}
+
+FuriString* furi_string_alloc(void) {
+    FuriString* string = calloc(1, sizeof(FuriString));
+    string_reserve(string, 0);
+    string->text[0] = '\0';
+    return string;
+}
+
+FuriString* furi_string_alloc_set_str(const char* text) {
+    FuriString* string = furi_string_alloc();
+    furi_string_set_str(string, text);
+    return string;
+}
+
+FuriString* furi_string_alloc_set_string(const FuriString* source) {
+    return furi_string_alloc_set_str(source->text);
+}
+
+FuriString* furi_string_alloc_printf(const char* format, ...) {
+    FuriString* string = furi_string_alloc();
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    string_reserve(string, length);
+    va_start(args, format);
+    vsnprintf(string->text, length + 1, format, args);
+    va_end(args);
+    string->size = length;
+    return string;
+}
+
+void furi_string_free(FuriString* string) {
+    free(string->text);
+    free(string);
+}
+
+void furi_string_set_strn(FuriString* string, const char* text, size_t length) {
+    string_reserve(string, length);
+    memmove(string->text, text, length);
+    string->text[length] = '\0';
+    string->size = length;
+}
+
+void furi_string_set_str(FuriString* string, const char* text) {
+    furi_string_set_strn(string, text, strlen(text));
+}
+
+void furi_string_set_string(FuriString* string, const FuriString* source) {
+    furi_string_set_strn(string, source->text, source->size);
+}
+
+void furi_string_reset(FuriString* string) {
+    furi_string_set_strn(string, "", 0);
+}
+
+size_t furi_string_size(const FuriString* string) {
+    return string->size;
+}
+
+char furi_string_get_char(const FuriString* string, size_t index) {
+    furi_check(index < string->size);
+    return string->text[index];
+}
+
+void furi_string_set_char(FuriString* string, size_t index, char character) {
+    furi_check(index < string->size);
+    string->text[index] = character;
+}
+
+const char* furi_string_get_cstr(const FuriString* string) {
+    return string->text;
+}
+
+void furi_string_cat_str(FuriString* string, const char* text) {
+    size_t length = strlen(text);
+    string_reserve(string, string->size + length);
+    memcpy(string->text + string->size, text, length + 1);
+    string->size += length;
+}
+
+void furi_string_cat_string(FuriString* string, const FuriString* source) {
+    furi_string_cat_str(string, source->text);
+}
+
+void furi_string_push_back(FuriString* string, char character) {
+    string_reserve(string, string->size + 1);
+    string->text[string->size++] = character;
+    string->text[string->size] = '\0';
+}
+
+static int string_cat_vprintf(FuriString* string, const char* format, va_list args) {
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    string_reserve(string, string->size + length);
+    vsnprintf(string->text + string->size, length + 1, format, args);
+    string->size += length;
+    return length;
+}
+
+int furi_string_printf(FuriString* string, const char* format, ...) {
+    furi_string_reset(string);
+    va_list args;
+    va_start(args, format);
+    int length = string_cat_vprintf(string, format, args);
+    va_end(args);
+    return length;
+}
+
+int furi_string_cat_printf(FuriString* string, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int length = string_cat_vprintf(string, format, args);
+    va_end(args);
+    return length;
+}
+
+void furi_string_replace_at(FuriString* string, size_t index, size_t length, const char* text) {
+    furi_check(index + length <= string->size);
+    FuriString* rest = furi_string_alloc_set_str(string->text + index + length);
+    furi_string_set_strn(string, string->text, index);
+    furi_string_cat_str(string, text);
+    furi_string_cat_str(string, rest->text);
+    furi_string_free(rest);
+}
+
+bool furi_string_empty(const FuriString* string) {
+    return string->size == 0;
+}
+
+bool furi_string_equal_str(const FuriString* string, const char* text) {
+    return strcmp(string->text, text) == 0;
+}
+
+bool furi_string_equal_string(const FuriString* string, const FuriString* other) {
+    return furi_string_equal_str(string, other->text);
+}
+
+size_t furi_string_search_rchar(const FuriString* string, char character, size_t start) {
+    const char* found = strrchr(string->text + MIN(start, string->size), character);
+    return found == NULL ? FURI_STRING_FAILURE : (size_t)(found - string->text);
+}
+
+void furi_string_left(FuriString* string, size_t index) {
+    if(index < string->size) {
+        string->size = index;
+        string->text[index] = '\0';
+    }
+}
+
+void furi_string_right(FuriString* string, size_t index) {
+    furi_string_set_str(string, string->text + MIN(index, string->size));
+}
+
+/**
+ * Message queue, semaphore, thread & timer
+*/
+
+struct FuriMessageQueue {
+    uint32_t count;
+};
+
+FuriMessageQueue* furi_message_queue_alloc(uint32_t count, uint32_t message_size) {
+    UNUSED(message_size);
+    FuriMessageQueue* queue = malloc(sizeof(FuriMessageQueue));
+    queue->count = count;
+    return queue;
+}
+
+void furi_message_queue_free(FuriMessageQueue* queue) {
+    free(queue);
+}
+
+struct FuriSemaphore {
+    pthread_mutex_t mutex;
+    pthread_cond_t released;
+    uint32_t max_count;
+    uint32_t count;
+};
+
+FuriSemaphore* furi_semaphore_alloc(uint32_t max_count, uint32_t initial_count) {
+    FuriSemaphore* semaphore = malloc(sizeof(FuriSemaphore));
+    pthread_mutex_init(&semaphore->mutex, NULL);
+    pthread_cond_init(&semaphore->released, NULL);
+    semaphore->max_count = max_count;
+    semaphore->count = initial_count;
+    return semaphore;
+}
+
+void furi_semaphore_free(FuriSemaphore* semaphore) {
+    pthread_cond_destroy(&semaphore->released);
+    pthread_mutex_destroy(&semaphore->mutex);
+    free(semaphore);
+}
+
+FuriStatus furi_semaphore_acquire(FuriSemaphore* semaphore, uint32_t timeout) {
+    struct timespec deadline = host_deadline(timeout);
+    pthread_mutex_lock(&semaphore->mutex);
+    int error = 0;
+    while(semaphore->count == 0 && timeout > 0 && error == 0) {
+        error = timeout == FuriWaitForever ?
+                    pthread_cond_wait(&semaphore->released, &semaphore->mutex) :
+                    pthread_cond_timedwait(&semaphore->released, &semaphore->mutex, &deadline);
+    }
+    FuriStatus status = FuriStatusErrorTimeout;
+    if(semaphore->count > 0) {
+        semaphore->count--;
+        status = FuriStatusOk;
+    }
+    pthread_mutex_unlock(&semaphore->mutex);
+    return status;
+}
+
+FuriStatus furi_semaphore_release(FuriSemaphore* semaphore) {
+    pthread_mutex_lock(&semaphore->mutex);
+    FuriStatus status = FuriStatusError;
+    if(semaphore->count < semaphore->max_count) {
+        semaphore->count++;
+        status = FuriStatusOk;
+        pthread_cond_signal(&semaphore->released);
+    }
+    pthread_mutex_unlock(&semaphore->mutex);
+    return status;
+}
+
+struct FuriThread {
+    pthread_t thread;
+    FuriThreadCallback callback;
+    void* context;
+    int32_t result;
+    bool started;
+};
+
+static void* thread_run(void* context) {
+    FuriThread* thread = context;
+    thread->result = thread->callback(thread->context);
+    return NULL;
+}
+
+FuriThread* furi_thread_alloc_ex(
+    const char* name,
+    uint32_t stack_size,
+    FuriThreadCallback callback,
+    void* context) {
+    UNUSED(name);
+    UNUSED(stack_size);
+    FuriThread* thread = calloc(1, sizeof(FuriThread));
+    thread->callback = callback;
+    thread->context = context;
+    return thread;
+}
+
+void furi_thread_free(FuriThread* thread) {
+    furi_check(!thread->started);
+    free(thread);
+}
+
+void furi_thread_start(FuriThread* thread) {
+    furi_check(!thread->started);
+    thread->started = pthread_create(&thread->thread, NULL, thread_run, thread) == 0;
+    furi_check(thread->started);
+}
+
+bool furi_thread_join(FuriThread* thread) {
+    if(thread->started) {
+        pthread_join(thread->thread, NULL);
+        thread->started = false;
+    }
+    return true;
+}
+
+FuriThreadId furi_thread_get_current_id(void) {
+    return (FuriThreadId)(uintptr_t)pthread_self();
+}
+
+//the stacks of a computer are much larger than the ones of the app, so their space is not measured
+uint32_t furi_thread_get_stack_space(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+    return 0;
+}
+
+struct FuriTimer {
+    FuriTimerCallback callback;
+    void* context;
+};
+
+FuriTimer* furi_timer_alloc(FuriTimerCallback callback, FuriTimerType type, void* context) {
+    UNUSED(type);
+    FuriTimer* timer = malloc(sizeof(FuriTimer));
+    timer->callback = callback;
+    timer->context = context;
+    return timer;
+}
+
+void furi_timer_free(FuriTimer* timer) {
+    free(timer);
+}
+
+FuriStatus furi_timer_start(FuriTimer* timer, uint32_t ticks) {
+    UNUSED(timer);
+    UNUSED(ticks);
+    return FuriStatusOk;
+}
+
+FuriStatus furi_timer_stop(FuriTimer* timer) {
+    UNUSED(timer);
+    return FuriStatusOk;
+}
+
+/**
+ * Canvas & elements
+*/
+
+struct Canvas {
+    //8 rows per byte with the top row in the least significant bit, like the frame buffer of the firmware
+    uint8_t buffer[128 * 64 / 8];
+    Color color;
+    Font font;
+};
+
+struct Icon {
+    uint8_t width;
+    uint8_t height;
+};
+
+//the icons fbt generates for the app, they are drawn as boxes
+const Icon I_barcode_10 = {10, 10};
+const Icon I_KeySaveSelected_22x11 = {22, 11};
+const Icon I_KeySave_22x11 = {22, 11};
+const Icon I_KeyKeyboardSelected_10x11 = {10, 11};
+const Icon I_KeyKeyboard_10x11 = {10, 11};
+const Icon I_KeyBackspaceSelected_17x11 = {17, 11};
+const Icon I_KeyBackspace_17x11 = {17, 11};
+
+//the calls the views made since host_sdk_reset_canvas_calls, the drivers draw on one thread
+static uint32_t canvas_calls[HostCanvasCallCount];
+
+uint32_t host_sdk_canvas_calls(HostCanvasCall call) {
+    return canvas_calls[call];
+}
+
+void host_sdk_reset_canvas_calls(void) {
+    memset(canvas_calls, 0, sizeof(canvas_calls));
+}
+
+static void canvas_pixel(Canvas* canvas, int32_t x, int32_t y) {
+    if(x < 0 || x >= 128 || y < 0 || y >= 64) {
+        return;
+    }
+    uint8_t* byte = &canvas->buffer[(y >> 3) * 128 + x];
+    uint8_t bit = 1 << (y & 7);
+    if(canvas->color == ColorXOR) {
+        *byte ^= bit;
+    } else if(canvas->color == ColorBlack) {
+        *byte |= bit;
+    } else {
+        *byte &= ~bit;
+    }
+}
+
+//the functions below draw for the canvas functions without counting a call, the canvas functions
+//only count the calls of the views
+
+static void canvas_reset(Canvas* canvas) {
+    memset(canvas->buffer, 0, sizeof(canvas->buffer));
+    //the GUI resets the color and the font before every frame
+    canvas->color = ColorBlack;
+    canvas->font = FontSecondary;
+}
+
+static void canvas_fill(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height) {
+    for(size_t row = 0; row < height; row++) {
+        for(size_t column = 0; column < width; column++) {
+            canvas_pixel(canvas, x + column, y + row);
+        }
+    }
+}
+
+static void canvas_outline(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height) {
+    if(width == 0 || height == 0) {
+        return;
+    }
+    canvas_fill(canvas, x, y, width, 1);
+    canvas_fill(canvas, x, y + height - 1, width, 1);
+    canvas_fill(canvas, x, y + 1, 1, height - 2);
+    canvas_fill(canvas, x + width - 1, y + 1, 1, height - 2);
+}
+
+void canvas_clear(Canvas* canvas) {
+    canvas_calls[HostCanvasClear]++;
+    canvas_reset(canvas);
+}
+
+size_t canvas_width(const Canvas* canvas) {
+    UNUSED(canvas);
+    return 128;
+}
+
+size_t canvas_height(const Canvas* canvas) {
+    UNUSED(canvas);
+    return 64;
+}
+
+uint8_t* canvas_get_buffer(Canvas* canvas) {
+    return canvas->buffer;
+}
+
+void canvas_set_color(Canvas* canvas, Color color) {
+    canvas_calls[HostCanvasSetColor]++;
+    canvas->color = color;
+}
+
+void canvas_set_font(Canvas* canvas, Font font) {
+    canvas_calls[HostCanvasSetFont]++;
+    canvas->font = font;
+}
+
+//every character is as wide as one of FontSecondary
+uint16_t canvas_string_width(Canvas* canvas, const char* text) {
+    UNUSED(canvas);
+    canvas_calls[HostCanvasStringWidth]++;
+    return strlen(text) * 5;
+}
+
+//the heights of the fonts of the firmware
+uint8_t canvas_current_font_height(const Canvas* canvas) {
+    static const uint8_t heights[] = {
+        [FontPrimary] = 8,
+        [FontSecondary] = 7,
+        [FontKeyboard] = 8,
+        [FontBigNumbers] = 15,
+        [FontBatteryPercent] = 6,
+    };
+    return heights[canvas->font];
+}
+
+void canvas_draw_dot(Canvas* canvas, int32_t x, int32_t y) {
+    canvas_calls[HostCanvasDrawDot]++;
+    canvas_pixel(canvas, x, y);
+}
+
+void canvas_draw_box(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height) {
+    canvas_calls[HostCanvasDrawBox]++;
+    canvas_fill(canvas, x, y, width, height);
+}
+
+void canvas_draw_frame(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height) {
+    canvas_calls[HostCanvasDrawFrame]++;
+    canvas_outline(canvas, x, y, width, height);
+}
+
+void canvas_draw_rframe(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    size_t radius) {
+    UNUSED(radius);
+    canvas_calls[HostCanvasDrawRFrame]++;
+    canvas_outline(canvas, x, y, width, height);
+}
+
+//xbm bitmaps store 8 columns per byte with the leftmost column in the least significant bit
+void canvas_draw_xbm(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap) {
+    canvas_calls[HostCanvasDrawXbm]++;
+    size_t stride = (width + 7) / 8;
+    for(size_t row = 0; row < height; row++) {
+        for(size_t column = 0; column < width; column++) {
+            if(bitmap[row * stride + column / 8] & (1 << (column % 8))) {
+                canvas_pixel(canvas, x + column, y + row);
+            }
+        }
+    }
+}
+
+void canvas_draw_icon(Canvas* canvas, int32_t x, int32_t y, const Icon* icon) {
+    canvas_calls[HostCanvasDrawIcon]++;
+    canvas_fill(canvas, x, y, icon->width, icon->height);
+}
+
+void canvas_draw_glyph(Canvas* canvas, int32_t x, int32_t y, uint16_t character) {
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(character);
+    canvas_calls[HostCanvasDrawGlyph]++;
+}
+
+void canvas_draw_str(Canvas* canvas, int32_t x, int32_t y, const char* text) {
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(text);
+    canvas_calls[HostCanvasDrawStr]++;
+}
+
+void canvas_draw_str_aligned(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    Align horizontal,
+    Align vertical,
+    const char* text) {
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(horizontal);
+    UNUSED(vertical);
+    UNUSED(text);
+    canvas_calls[HostCanvasDrawStrAligned]++;
+}
+
+void elements_multiline_text(Canvas* canvas, int32_t x, int32_t y, const char* text) {
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(text);
+    canvas_calls[HostCanvasMultilineText]++;
+}
+
+void elements_multiline_text_aligned(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    Align horizontal,
+    Align vertical,
+    const char* text) {
+    UNUSED(canvas);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(horizontal);
+    UNUSED(vertical);
+    UNUSED(text);
+    canvas_calls[HostCanvasMultilineTextAligned]++;
+}
+
+void elements_slightly_rounded_box(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height) {
+    canvas_calls[HostCanvasRoundedBox]++;
+    canvas_fill(canvas, x, y, width, height);
+}
+
+void elements_slightly_rounded_frame(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height) {
+    canvas_calls[HostCanvasRoundedFrame]++;
+    canvas_outline(canvas, x, y, width, height);
+}
+
+/**
+ * View
+*/
+
+struct View {
+    ViewDrawCallback draw_callback;
+    ViewInputCallback input_callback;
+    ViewNavigationCallback previous_callback;
+    void* context;
+    ViewModelType model_type;
+    void* model;
+    pthread_mutex_t model_mutex;
+    ViewDispatcher* view_dispatcher; //the dispatcher the view was added to, it draws the view
+};
+
+static atomic_uint_fast32_t redraws;
+
+static void view_dispatcher_request_frame(ViewDispatcher* view_dispatcher, View* view);
+
+View* view_alloc(void) {
+    View* view = calloc(1, sizeof(View));
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&view->model_mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+    return view;
+}
+
+void view_free(View* view) {
+    free(view->model);
+    pthread_mutex_destroy(&view->model_mutex);
+    free(view);
+}
+
+void view_set_context(View* view, void* context) {
+    view->context = context;
+}
+
+void view_allocate_model(View* view, ViewModelType type, size_t size) {
+    view->model_type = type;
+    view->model = calloc(1, size);
+}
+
+void view_set_draw_callback(View* view, ViewDrawCallback callback) {
+    view->draw_callback = callback;
+}
+
+void view_set_input_callback(View* view, ViewInputCallback callback) {
+    view->input_callback = callback;
+}
+
+void view_set_previous_callback(View* view, ViewNavigationCallback callback) {
+    view->previous_callback = callback;
+}
+
+void* view_get_model(View* view) {
+    if(view->model_type == ViewModelTypeLocking) {
+        pthread_mutex_lock(&view->model_mutex);
+    }
+    return view->model;
+}
+
+void view_commit_model(View* view, bool update) {
+    if(view->model_type == ViewModelTypeLocking) {
+        pthread_mutex_unlock(&view->model_mutex);
+    }
+    if(update) {
+        redraws++;
+        if(view->view_dispatcher != NULL) {
+            view_dispatcher_request_frame(view->view_dispatcher, view);
+        }
+    }
+}
+
+static void view_draw(View* view, Canvas* canvas) {
+    if(view->draw_callback != NULL) {
+        void* model = view_get_model(view);
+        view->draw_callback(canvas, model);
+        view_commit_model(view, false);
+    }
+}
+
+void host_view_draw(View* view, Canvas* canvas) {
+    canvas_reset(canvas);
+    view_draw(view, canvas);
+}
+
+bool host_view_input(View* view, InputEvent* event) {
+    return view->input_callback != NULL && view->input_callback(event, view->context);
+}
+
+uint32_t host_sdk_redraws(void) {
+    return redraws;
+}
+
+/**
+ * GUI & input service
+*/
+
+struct Gui {
+    Canvas canvas;
+    ViewDispatcher* view_dispatcher; //the dispatcher the inputs are sent to
+    struct {
+        GuiCanvasCommitCallback callback;
+        void* context;
+    } framebuffer_callbacks[HOST_MAX_FRAMEBUFFER_CALLBACKS];
+};
+
+struct FuriPubSub {
+    Gui* gui;
+};
+
+static Gui gui;
+static FuriPubSub input_events = {.gui = &gui};
+
+void gui_add_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback, void* context) {
+    for(size_t i = 0; i < HOST_MAX_FRAMEBUFFER_CALLBACKS; i++) {
+        if(gui->framebuffer_callbacks[i].callback == NULL) {
+            gui->framebuffer_callbacks[i].callback = callback;
+            gui->framebuffer_callbacks[i].context = context;
+            return;
+        }
+    }
+    furi_crash("too many frame buffer callbacks");
+}
+
+void gui_remove_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback, void* context) {
+    for(size_t i = 0; i < HOST_MAX_FRAMEBUFFER_CALLBACKS; i++) {
+        if(gui->framebuffer_callbacks[i].callback == callback &&
+           gui->framebuffer_callbacks[i].context == context) {
+            gui->framebuffer_callbacks[i].callback = NULL;
+        }
+    }
+}
+
+Canvas* gui_direct_draw_acquire(Gui* gui) {
+    canvas_reset(&gui->canvas);
+    return &gui->canvas;
+}
+
+void gui_direct_draw_release(Gui* gui) {
+    UNUSED(gui);
+}
+
+//sends the frame of the canvas to the frame buffer callbacks, like the GUI thread does after drawing
+static void gui_commit(Gui* gui) {
+    for(size_t i = 0; i < HOST_MAX_FRAMEBUFFER_CALLBACKS; i++) {
+        if(gui->framebuffer_callbacks[i].callback != NULL) {
+            gui->framebuffer_callbacks[i].callback(
+                gui->canvas.buffer,
+                sizeof(gui->canvas.buffer),
+                CanvasOrientationHorizontal,
+                gui->framebuffer_callbacks[i].context);
+        }
+    }
+}
+
+/**
+ * View dispatcher
+*/
+
+typedef enum {
+    HostEventInput,
+    HostEventCustom,
+    HostEventStop,
+} HostEventType;
+
+typedef struct {
+    HostEventType type;
+    InputEvent input;
+    uint32_t custom;
+} HostEvent;
+
+struct ViewDispatcher {
+    Gui* gui;
+    struct {
+        uint32_t id;
+        View* view;
+    } views[HOST_MAX_VIEWS];
+    size_t view_count;
+    View* current_view;
+
+    uint8_t ongoing_input; //a bit for every key that was pressed and not released
+    View* ongoing_input_view; //the view that got the first press of the ongoing input
+
+    ViewDispatcherCustomEventCallback custom_event_callback;
+    void* event_context;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t changed; //an event was queued or a frame was requested
+    HostEvent queue[HOST_QUEUE_SIZE];
+    size_t queue_start;
+    size_t queue_count;
+    bool frame_requested;
+};
+
+ViewDispatcher* view_dispatcher_alloc(void) {
+    ViewDispatcher* view_dispatcher = calloc(1, sizeof(ViewDispatcher));
+    pthread_mutex_init(&view_dispatcher->mutex, NULL);
+    pthread_cond_init(&view_dispatcher->changed, NULL);
+    return view_dispatcher;
+}
+
+void view_dispatcher_free(ViewDispatcher* view_dispatcher) {
+    if(gui.view_dispatcher == view_dispatcher) {
+        gui.view_dispatcher = NULL;
+    }
+    pthread_cond_destroy(&view_dispatcher->changed);
+    pthread_mutex_destroy(&view_dispatcher->mutex);
+    free(view_dispatcher);
+}
+
+void view_dispatcher_enable_queue(ViewDispatcher* view_dispatcher) {
+    UNUSED(view_dispatcher);
+}
+
+void view_dispatcher_attach_to_gui(
+    ViewDispatcher* view_dispatcher,
+    Gui* gui,
+    ViewDispatcherType type) {
+    UNUSED(type);
+    view_dispatcher->gui = gui;
+    gui->view_dispatcher = view_dispatcher;
+}
+
+void view_dispatcher_set_event_callback_context(ViewDispatcher* view_dispatcher, void* context) {
+    view_dispatcher->event_context = context;
+}
+
+void view_dispatcher_set_custom_event_callback(
+    ViewDispatcher* view_dispatcher,
+    ViewDispatcherCustomEventCallback callback) {
+    view_dispatcher->custom_event_callback = callback;
+}
+
+void view_dispatcher_add_view(ViewDispatcher* view_dispatcher, uint32_t view_id, View* view) {
+    furi_check(view_dispatcher->view_count < HOST_MAX_VIEWS);
+    view_dispatcher->views[view_dispatcher->view_count].id = view_id;
+    view_dispatcher->views[view_dispatcher->view_count].view = view;
+    view_dispatcher->view_count++;
+    view->view_dispatcher = view_dispatcher;
+}
+
+void view_dispatcher_remove_view(ViewDispatcher* view_dispatcher, uint32_t view_id) {
+    for(size_t i = 0; i < view_dispatcher->view_count; i++) {
+        if(view_dispatcher->views[i].id == view_id) {
+            View* view = view_dispatcher->views[i].view;
+            if(view_dispatcher->current_view == view) {
+                view_dispatcher->current_view = NULL;
+            }
+            if(view_dispatcher->ongoing_input_view == view) {
+                view_dispatcher->ongoing_input_view = NULL;
+            }
+            view->view_dispatcher = NULL;
+            view_dispatcher->views[i] = view_dispatcher->views[--view_dispatcher->view_count];
+            return;
+        }
+    }
+}
+
+static void view_dispatcher_request_frame(ViewDispatcher* view_dispatcher, View* view) {
+    pthread_mutex_lock(&view_dispatcher->mutex);
+    if(view == view_dispatcher->current_view) {
+        view_dispatcher->frame_requested = true;
+        pthread_cond_signal(&view_dispatcher->changed);
+    }
+    pthread_mutex_unlock(&view_dispatcher->mutex);
+}
+
+void view_dispatcher_switch_to_view(ViewDispatcher* view_dispatcher, uint32_t view_id) {
+    redraws++;
+    View* view = NULL;
+    for(size_t i = 0; i < view_dispatcher->view_count; i++) {
+        if(view_dispatcher->views[i].id == view_id) {
+            view = view_dispatcher->views[i].view;
+        }
+    }
+    furi_check(view != NULL);
+
+    pthread_mutex_lock(&view_dispatcher->mutex);
+    view_dispatcher->current_view = view;
+    view_dispatcher->frame_requested = true;
+    pthread_cond_signal(&view_dispatcher->changed);
+    pthread_mutex_unlock(&view_dispatcher->mutex);
+}
+
+static void view_dispatcher_queue(ViewDispatcher* view_dispatcher, const HostEvent* event) {
+    pthread_mutex_lock(&view_dispatcher->mutex);
+    furi_check(view_dispatcher->queue_count < HOST_QUEUE_SIZE);
+    size_t index = (view_dispatcher->queue_start + view_dispatcher->queue_count) % HOST_QUEUE_SIZE;
+    view_dispatcher->queue[index] = *event;
+    view_dispatcher->queue_count++;
+    pthread_cond_signal(&view_dispatcher->changed);
+    pthread_mutex_unlock(&view_dispatcher->mutex);
+}
+
+void view_dispatcher_send_custom_event(ViewDispatcher* view_dispatcher, uint32_t event) {
+    view_dispatcher_queue(view_dispatcher, &(HostEvent){.type = HostEventCustom, .custom = event});
+}
+
+void view_dispatcher_stop(ViewDispatcher* view_dispatcher) {
+    view_dispatcher_queue(view_dispatcher, &(HostEvent){.type = HostEventStop});
+}
+
+void furi_pubsub_publish(FuriPubSub* pubsub, void* message) {
+    furi_check(pubsub == &input_events && pubsub->gui->view_dispatcher != NULL);
+    view_dispatcher_queue(
+        pubsub->gui->view_dispatcher,
+        &(HostEvent){.type = HostEventInput, .input = *(InputEvent*)message});
+}
+
+/**
+ * Sends an input to the current view like the dispatcher of the firmware: the events of a key go to the view
+ * that got its press, and a short or long back that the view does not handle goes to the previous view
+*/
+static void view_dispatcher_handle_input(ViewDispatcher* view_dispatcher, InputEvent* event) {
+    uint8_t key_bit = 1 << event->key;
+    if(event->type == InputTypePress) {
+        view_dispatcher->ongoing_input |= key_bit;
+    } else if(event->type == InputTypeRelease) {
+        view_dispatcher->ongoing_input &= ~key_bit;
+    } else if(!(view_dispatcher->ongoing_input & key_bit)) {
+        return;
+    }
+
+    if(event->type == InputTypePress && !(view_dispatcher->ongoing_input & ~key_bit)) {
+        view_dispatcher->ongoing_input_view = view_dispatcher->current_view;
+    }
+
+    View* current_view = view_dispatcher->current_view;
+    if(current_view != NULL && current_view == view_dispatcher->ongoing_input_view) {
+        bool consumed = host_view_input(current_view, event);
+        if(!consumed && event->key == InputKeyBack &&
+           (event->type == InputTypeShort || event->type == InputTypeLong)) {
+            uint32_t view_id = current_view->previous_callback != NULL ?
+                                   current_view->previous_callback(current_view->context) :
+                                   VIEW_NONE;
+            if(view_id == VIEW_NONE) {
+                view_dispatcher_stop(view_dispatcher);
+            } else {
+                view_dispatcher_switch_to_view(view_dispatcher, view_id);
+            }
+        }
+    } else if(view_dispatcher->ongoing_input_view != NULL && event->type == InputTypeRelease) {
+        host_view_input(view_dispatcher->ongoing_input_view, event);
+    }
+}
+
+static void view_dispatcher_draw(ViewDispatcher* view_dispatcher) {
+    Gui* gui = view_dispatcher->gui;
+    if(view_dispatcher->current_view != NULL) {
+        host_view_draw(view_dispatcher->current_view, &gui->canvas);
+    } else {
+        canvas_reset(&gui->canvas);
+    }
+    gui_commit(gui);
+}
+
+/**
+ * Waits for the next input of the dispatcher for a modal dialog that runs on the dispatcher thread, the
+ * other events stay queued for the dispatcher
+*/
+static InputEvent view_dispatcher_take_input(ViewDispatcher* view_dispatcher) {
+    pthread_mutex_lock(&view_dispatcher->mutex);
+    while(true) {
+        for(size_t i = 0; i < view_dispatcher->queue_count; i++) {
+            size_t index = (view_dispatcher->queue_start + i) % HOST_QUEUE_SIZE;
+            if(view_dispatcher->queue[index].type != HostEventInput) {
+                continue;
+            }
+            InputEvent input = view_dispatcher->queue[index].input;
+            for(size_t j = i + 1; j < view_dispatcher->queue_count; j++) {
+                size_t next = (view_dispatcher->queue_start + j) % HOST_QUEUE_SIZE;
+                view_dispatcher->queue[index] = view_dispatcher->queue[next];
+                index = next;
+            }
+            view_dispatcher->queue_count--;
+            pthread_mutex_unlock(&view_dispatcher->mutex);
+            return input;
+        }
+        pthread_cond_wait(&view_dispatcher->changed, &view_dispatcher->mutex);
+    }
+}
+
+void view_dispatcher_run(ViewDispatcher* view_dispatcher) {
+    furi_check(view_dispatcher->gui != NULL);
+    bool running = true;
+    while(running) {
+        pthread_mutex_lock(&view_dispatcher->mutex);
+        while(view_dispatcher->queue_count == 0 && !view_dispatcher->frame_requested) {
+            pthread_cond_wait(&view_dispatcher->changed, &view_dispatcher->mutex);
+        }
+        bool draw = view_dispatcher->frame_requested;
+        view_dispatcher->frame_requested = false;
+        HostEvent event = {.type = HostEventCustom};
+        bool has_event = !draw && view_dispatcher->queue_count > 0;
+        if(has_event) {
+            event = view_dispatcher->queue[view_dispatcher->queue_start];
+            view_dispatcher->queue_start = (view_dispatcher->queue_start + 1) % HOST_QUEUE_SIZE;
+            view_dispatcher->queue_count--;
+        }
+        pthread_mutex_unlock(&view_dispatcher->mutex);
+
+        //a frame that was asked for is drawn before the next event, like the GUI thread of the firmware
+        if(draw) {
+            view_dispatcher_draw(view_dispatcher);
+        } else if(event.type == HostEventInput) {
+            view_dispatcher_handle_input(view_dispatcher, &event.input);
+        } else if(event.type == HostEventCustom) {
+            if(view_dispatcher->custom_event_callback != NULL) {
+                view_dispatcher->custom_event_callback(
+                    view_dispatcher->event_context, event.custom);
+            }
+        } else {
+            running = false;
+        }
+    }
+}
+
+/**
+ * Submenu & widget
+*/
+
+struct Submenu {
+    View* view;
+};
+
+typedef struct {
+    struct {
+        const char* label;
+        uint32_t index;
+        SubmenuItemCallback callback;
+        void* context;
+    } items[HOST_MAX_SUBMENU_ITEMS];
+    size_t count;
+    size_t selected;
+} SubmenuModel;
+
+static void submenu_draw_callback(Canvas* canvas, void* context) {
+    SubmenuModel* model = context;
+    for(size_t i = 0; i < model->count && i < 4; i++) {
+        canvas_draw_str(canvas, 6, 11 + i * 16, model->items[i].label);
+    }
+}
+
+static bool submenu_input_callback(InputEvent* event, void* context) {
+    Submenu* submenu = context;
+    if(event->type != InputTypeShort && event->type != InputTypeRepeat) {
+        return event->key != InputKeyBack;
+    }
+
+    SubmenuItemCallback callback = NULL;
+    void* callback_context = NULL;
+    uint32_t index = 0;
+    bool consumed = true;
+    with_view_model(
+        submenu->view,
+        SubmenuModel * model,
+        {
+            if(model->count == 0) {
+                consumed = false;
+            } else if(event->key == InputKeyUp) {
+                model->selected = (model->selected + model->count - 1) % model->count;
+            } else if(event->key == InputKeyDown) {
+                model->selected = (model->selected + 1) % model->count;
+            } else if(event->key == InputKeyOk && event->type == InputTypeShort) {
+                callback = model->items[model->selected].callback;
+                callback_context = model->items[model->selected].context;
+                index = model->items[model->selected].index;
+            } else {
+                consumed = false;
+            }
+        },
+        consumed);
+
+    if(callback != NULL) {
+        callback(callback_context, index);
+    }
+    return consumed;
+}
+
+Submenu* submenu_alloc(void) {
+    Submenu* submenu = malloc(sizeof(Submenu));
+    submenu->view = view_alloc();
+    view_set_context(submenu->view, submenu);
+    view_allocate_model(submenu->view, ViewModelTypeLocking, sizeof(SubmenuModel));
+    view_set_draw_callback(submenu->view, submenu_draw_callback);
+    view_set_input_callback(submenu->view, submenu_input_callback);
+    return submenu;
+}
+
+void submenu_free(Submenu* submenu) {
+    view_free(submenu->view);
+    free(submenu);
+}
+
+View* submenu_get_view(Submenu* submenu) {
+    return submenu->view;
+}
+
+void submenu_add_item(
+    Submenu* submenu,
+    const char* label,
+    uint32_t index,
+    SubmenuItemCallback callback,
+    void* context) {
+    with_view_model(
+        submenu->view,
+        SubmenuModel * model,
+        {
+            furi_check(model->count < HOST_MAX_SUBMENU_ITEMS);
+            model->items[model->count].label = label;
+            model->items[model->count].index = index;
+            model->items[model->count].callback = callback;
+            model->items[model->count].context = context;
+            model->count++;
+        },
+        true);
+}
+
+struct Widget {
+    View* view;
+};
+
+typedef struct {
+    const char* text;
+} WidgetModel;
+
+static void widget_draw_callback(Canvas* canvas, void* context) {
+    WidgetModel* model = context;
+    if(model->text != NULL) {
+        elements_multiline_text(canvas, 0, 10, model->text);
+    }
+}
+
+//the text scrolls with up and down
+static bool widget_input_callback(InputEvent* event, void* context) {
+    UNUSED(context);
+    return event->key == InputKeyUp || event->key == InputKeyDown;
+}
+
+Widget* widget_alloc(void) {
+    Widget* widget = malloc(sizeof(Widget));
+    widget->view = view_alloc();
+    view_set_context(widget->view, widget);
+    view_allocate_model(widget->view, ViewModelTypeLocking, sizeof(WidgetModel));
+    view_set_draw_callback(widget->view, widget_draw_callback);
+    view_set_input_callback(widget->view, widget_input_callback);
+    return widget;
+}
+
+void widget_free(Widget* widget) {
+    view_free(widget->view);
+    free(widget);
+}
+
+void widget_reset(Widget* widget) {
+    with_view_model(widget->view, WidgetModel * model, { model->text = NULL; }, true);
+}
+
+View* widget_get_view(Widget* widget) {
+    return widget->view;
+}
+
+void widget_add_text_scroll_element(
+    Widget* widget,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height,
+    const char* text) {
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(width);
+    UNUSED(height);
+    with_view_model(widget->view, WidgetModel * model, { model->text = text; }, true);
+}
+
+/**
+ * Storage & flipper format
+*/
+
+struct Storage {
+    char folder[HOST_PATH_SIZE]; //the folder /ext is in
+};
+
+struct File {
+    FILE* file;
+};
+
+static Storage storage = {.folder = "."};
+
+void host_sdk_set_storage(const char* folder) {
+    snprintf(storage.folder, sizeof(storage.folder), "%s", folder);
+}
+
+//the path of a file of the SD card on the computer
+static void storage_path(const char* path, char* host_path) {
+    const char* ext = EXT_PATH("");
+    if(strncmp(path, ext, strlen(ext)) == 0) {
+        path += strlen(ext) - 1;
+    }
+    snprintf(host_path, HOST_PATH_SIZE, "%s%s", storage.folder, path);
+}
+
+//creates the parent folders of the path too, the SD card of a Flipper already has apps_data
+bool storage_simply_mkdir(Storage* storage, const char* path) {
+    UNUSED(storage);
+    char host_path[HOST_PATH_SIZE];
+    storage_path(path, host_path);
+    for(char* slash = strchr(host_path + 1, '/'); slash != NULL; slash = strchr(slash + 1, '/')) {
+        *slash = '\0';
+        mkdir(host_path, 0755);
+        *slash = '/';
+    }
+    return mkdir(host_path, 0755) == 0 || errno == EEXIST;
+}
+
+bool storage_simply_remove(Storage* storage, const char* path) {
+    UNUSED(storage);
+    char host_path[HOST_PATH_SIZE];
+    storage_path(path, host_path);
+    return remove(host_path) == 0 || errno == ENOENT;
+}
+
+FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path) {
+    UNUSED(storage);
+    char host_old_path[HOST_PATH_SIZE];
+    char host_new_path[HOST_PATH_SIZE];
+    storage_path(old_path, host_old_path);
+    storage_path(new_path, host_new_path);
+    return rename(host_old_path, host_new_path) == 0 ? FSE_OK : FSE_INTERNAL;
+}
+
+FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* file_info) {
+    UNUSED(storage);
+    char host_path[HOST_PATH_SIZE];
+    storage_path(path, host_path);
+    struct stat host_stat;
+    if(stat(host_path, &host_stat) != 0) {
+        return FSE_NOT_EXIST;
+    }
+    file_info->flags = S_ISDIR(host_stat.st_mode);
+    file_info->size = host_stat.st_size;
+    return FSE_OK;
+}
+
+const char* storage_error_get_desc(FS_Error error) {
+    return error == FSE_OK ? "OK" : "error";
+}
+
+File* storage_file_alloc(Storage* storage) {
+    UNUSED(storage);
+    return calloc(1, sizeof(File));
+}
+
+void storage_file_free(File* file) {
+    storage_file_close(file);
+    free(file);
+}
+
+bool storage_file_open(File* file, const char* path, FS_AccessMode access, FS_OpenMode mode) {
+    char host_path[HOST_PATH_SIZE];
+    storage_path(path, host_path);
+    const char* host_mode = access == FSAM_READ ? "rb" : "r+b";
+    if(mode == FSOM_CREATE_ALWAYS) {
+        host_mode = "w+b";
+    } else if(mode == FSOM_OPEN_APPEND) {
+        host_mode = "a+b";
+    } else if(mode == FSOM_CREATE_NEW || mode == FSOM_OPEN_ALWAYS) {
+        struct stat host_stat;
+        bool exists = stat(host_path, &host_stat) == 0;
+        if(exists && mode == FSOM_CREATE_NEW) {
+            return false;
+        }
+        host_mode = exists ? host_mode : "w+b";
+    }
+    file->file = fopen(host_path, host_mode);
+    return file->file != NULL;
+}
+
+bool storage_file_close(File* file) {
+    if(file->file != NULL) {
+        fclose(file->file);
+        file->file = NULL;
+    }
+    return true;
+}
+
+size_t storage_file_read(File* file, void* data, size_t size) {
+    return file->file != NULL ? fread(data, 1, size, file->file) : 0;
+}
+
+size_t storage_file_write(File* file, const void* data, size_t size) {
+    return file->file != NULL ? fwrite(data, 1, size, file->file) : 0;
+}
+
+uint64_t storage_file_size(File* file) {
+    if(file->file == NULL) {
+        return 0;
+    }
+    struct stat host_stat;
+    return fstat(fileno(file->file), &host_stat) == 0 ? (uint64_t)host_stat.st_size : 0;
+}
+
+struct FlipperFormat {
+    FILE* file;
+};
+
+FlipperFormat* flipper_format_file_alloc(Storage* storage) {
+    UNUSED(storage);
+    return calloc(1, sizeof(FlipperFormat));
+}
+
+void flipper_format_free(FlipperFormat* flipper_format) {
+    if(flipper_format->file != NULL) {
+        fclose(flipper_format->file);
+    }
+    free(flipper_format);
+}
+
+static bool flipper_format_open(FlipperFormat* flipper_format, const char* path, const char* mode) {
+    char host_path[HOST_PATH_SIZE];
+    storage_path(path, host_path);
+    flipper_format->file = fopen(host_path, mode);
+    return flipper_format->file != NULL;
+}
+
+bool flipper_format_file_open_existing(FlipperFormat* flipper_format, const char* path) {
+    return flipper_format_open(flipper_format, path, "r");
+}
+
+bool flipper_format_file_open_new(FlipperFormat* flipper_format, const char* path) {
+    return flipper_format_open(flipper_format, path, "wx");
+}
+
+bool flipper_format_file_open_always(FlipperFormat* flipper_format, const char* path) {
+    return flipper_format_open(flipper_format, path, "w");
+}
+
+bool flipper_format_rewind(FlipperFormat* flipper_format) {
+    rewind(flipper_format->file);
+    return true;
+}
+
+bool flipper_format_read_string(FlipperFormat* flipper_format, const char* key, FuriString* data) {
+    char line[HOST_PATH_SIZE];
+    size_t key_length = strlen(key);
+    while(fgets(line, sizeof(line), flipper_format->file) != NULL) {
+        if(strncmp(line, key, key_length) == 0 && line[key_length] == ':' &&
+           line[key_length + 1] == ' ') {
+            char* value = line + key_length + 2;
+            value[strcspn(value, "\r\n")] = '\0';
+            furi_string_set_str(data, value);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool flipper_format_write_string_cstr(
+    FlipperFormat* flipper_format,
+    const char* key,
+    const char* data) {
+    return fprintf(flipper_format->file, "%s: %s\n", key, data) > 0;
+}
+
+bool flipper_format_write_comment_cstr(FlipperFormat* flipper_format, const char* data) {
+    return fprintf(flipper_format->file, "# %s\n", data) > 0;
+}
+
+/**
+ * Dialogs & notifications
+*/
+
+struct DialogsApp {
+    uint8_t unused;
+};
+
+void dialog_file_browser_set_basic_options(
+    DialogsFileBrowserOptions* options,
+    const char* extension,
+    const Icon* icon) {
+    memset(options, 0, sizeof(DialogsFileBrowserOptions));
+    options->extension = extension;
+    options->icon = icon;
+}
+
+//files that start with a dot are skipped, the app keeps its debug files there
+bool dialog_file_browser_show(
+    DialogsApp* context,
+    FuriString* result_path,
+    FuriString* path,
+    const DialogsFileBrowserOptions* options) {
+    UNUSED(context);
+    char host_path[HOST_PATH_SIZE];
+    storage_path(furi_string_get_cstr(path), host_path);
+    DIR* folder = opendir(host_path);
+    if(folder == NULL) {
+        return false;
+    }
+
+    char first[256] = "";
+    size_t extension_length = strlen(options->extension);
+    for(struct dirent* entry = readdir(folder); entry != NULL; entry = readdir(folder)) {
+        size_t length = strlen(entry->d_name);
+        if(entry->d_name[0] == '.' || entry->d_type != DT_REG || length < extension_length ||
+           strcmp(entry->d_name + length - extension_length, options->extension) != 0) {
+            continue;
+        }
+        if(first[0] == '\0' || strcmp(entry->d_name, first) < 0) {
+            snprintf(first, sizeof(first), "%s", entry->d_name);
+        }
+    }
+    closedir(folder);
+
+    //the browser is modal: it draws a frame when it opens and on every key, a short ok selects the first
+    //file and a short back cancels it
+    ViewDispatcher* view_dispatcher = gui.view_dispatcher;
+    furi_check(view_dispatcher != NULL);
+    canvas_reset(&gui.canvas);
+    gui_commit(&gui);
+    InputKey closed_by = InputKeyMAX;
+    while(true) {
+        InputEvent input = view_dispatcher_take_input(view_dispatcher);
+        if(input.type == InputTypePress) {
+            gui_commit(&gui);
+        } else if(
+            input.type == InputTypeShort && (input.key == InputKeyOk || input.key == InputKeyBack)) {
+            closed_by = input.key;
+        } else if(input.type == InputTypeRelease && input.key == closed_by) {
+            break;
+        }
+    }
+    bool selected_first = closed_by == InputKeyOk;
+    //the dialog took the releases of the keys the view below got the press of
+    view_dispatcher->ongoing_input = 0;
+    view_dispatcher->ongoing_input_view = NULL;
+
+    if(first[0] == '\0' || !selected_first) {
+        return false;
+    }
+    FuriString* selected = furi_string_alloc_printf("%s/%s", furi_string_get_cstr(path), first);
+    furi_string_set(result_path, selected);
+    furi_string_free(selected);
+    return true;
+}
+
+struct NotificationSequence {
+    uint8_t unused;
+};
+
+const NotificationSequence sequence_display_backlight_on;
+const NotificationSequence sequence_display_backlight_enforce_on;
+const NotificationSequence sequence_display_backlight_enforce_auto;
+
+void notification_message(NotificationApp* app, const NotificationSequence* sequence) {
+    UNUSED(app);
+    UNUSED(sequence);
+}
+
+void notification_message_block(NotificationApp* app, const NotificationSequence* sequence) {
+    UNUSED(app);
+    UNUSED(sequence);
+}
+
+/**
+ * Records
+*/
+
+static DialogsApp dialogs;
+static NotificationApp notifications = {.settings = {.display_brightness = 1.0f}};
+
+void* furi_record_open(const char* name) {
+    if(strcmp(name, RECORD_GUI) == 0) {
+        return &gui;
+    } else if(strcmp(name, RECORD_STORAGE) == 0) {
+        return &storage;
+    } else if(strcmp(name, RECORD_DIALOGS) == 0) {
+        return &dialogs;
+    } else if(strcmp(name, RECORD_NOTIFICATION) == 0) {
+        return &notifications;
+    } else if(strcmp(name, RECORD_INPUT_EVENTS) == 0) {
+        return &input_events;
+    }
+    furi_crash(name);
+    return NULL;
+}
+
+void furi_record_close(const char* name) {
+    UNUSED(name);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <furi.h>
+
+//the paths of the SD card, /ext/..., are files in the folder set by host_sdk_set_storage
+typedef struct Storage Storage;
+typedef struct File File;
+
+typedef enum {
+    FSE_OK,
+    FSE_NOT_READY,
+    FSE_EXIST,
+    FSE_NOT_EXIST,
+    FSE_INTERNAL,
+} FS_Error;
+
+typedef enum {
+    FSAM_READ = 1,
+    FSAM_WRITE = 2,
+} FS_AccessMode;
+
+typedef enum {
+    FSOM_OPEN_EXISTING = 1,
+    FSOM_OPEN_ALWAYS = 2,
+    FSOM_OPEN_APPEND = 4,
+    FSOM_CREATE_NEW = 8,
+    FSOM_CREATE_ALWAYS = 16,
+} FS_OpenMode;
+
+typedef struct {
+    uint32_t flags;
+    uint64_t size;
+} FileInfo;
+
+bool storage_simply_mkdir(Storage* storage, const char* path);
+bool storage_simply_remove(Storage* storage, const char* path);
+FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path);
+FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* file_info);
+const char* storage_error_get_desc(FS_Error error);
+
+File* storage_file_alloc(Storage* storage);
+void storage_file_free(File* file);
+bool storage_file_open(File* file, const char* path, FS_AccessMode access, FS_OpenMode mode);
+bool storage_file_close(File* file);
+size_t storage_file_read(File* file, void* data, size_t size);
+size_t storage_file_write(File* file, const void* data, size_t size);
+uint64_t storage_file_size(File* file);
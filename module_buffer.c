@@ -0,0 +1,128 @@
+#include "module_buffer.h"
+
+/**
+ * Allocates a buffer that can hold capacity modules and their guard flags
+ * The modules and guards are stored in the same allocation
+*/
+ModuleBuffer* module_buffer_alloc(size_t capacity) {
+    size_t bytes = MODULE_BUFFER_BYTES(capacity);
+    ModuleBuffer* buffer = barcode_alloc(sizeof(ModuleBuffer) + bytes * 2);
+    uint8_t* storage = (uint8_t*)(buffer + 1);
+    module_buffer_init(buffer, storage, storage + bytes, capacity);
+    return buffer;
+}
+
+void module_buffer_free(ModuleBuffer* buffer) {
+    barcode_alloc_free(buffer);
+}
+
+/**
+ * Sets up a buffer on top of memory owned by the caller, nothing is allocated
+ * @param storage  must be at least MODULE_BUFFER_BYTES(capacity) bytes long
+ * @param guard_storage  the same size as storage, NULL to not keep the guard flags
+ * @param capacity  the number of modules that fit in storage
+*/
+void module_buffer_init(
+    ModuleBuffer* buffer,
+    uint8_t* storage,
+    uint8_t* guard_storage,
+    size_t capacity) {
+    buffer->data = storage;
+    buffer->guards = guard_storage;
+    buffer->length = 0;
+    buffer->capacity = capacity;
+}
+
+/**
+ * Removes all modules from the buffer, the memory is kept for reuse
+*/
+void module_buffer_reset(ModuleBuffer* buffer) {
+    buffer->length = 0;
+}
+
+size_t module_buffer_size(const ModuleBuffer* buffer) {
+    return buffer->length;
+}
+
+/**
+ * @returns true if the module at index is a bar, false if it is a space
+*/
+bool module_buffer_get(const ModuleBuffer* buffer, size_t index) {
+    return (buffer->data[index >> 3] >> (7 - (index & 7))) & 1;
+}
+
+/**
+ * @returns true if the module at index is part of a guard pattern
+*/
+bool module_buffer_is_guard(const ModuleBuffer* buffer, size_t index) {
+    if(buffer->guards == NULL) {
+        return false;
+    }
+    return (buffer->guards[index >> 3] >> (7 - (index & 7))) & 1;
+}
+
+static void set_bit(uint8_t* bits, size_t index, bool value) {
+    uint8_t mask = 1 << (7 - (index & 7));
+    if(value) {
+        bits[index >> 3] |= mask;
+    } else {
+        bits[index >> 3] &= ~mask;
+    }
+}
+
+static void append_module(ModuleBuffer* buffer, bool module, bool guard) {
+    if(buffer->length >= buffer->capacity) {
+        return;
+    }
+
+    set_bit(buffer->data, buffer->length, module);
+    if(buffer->guards != NULL) {
+        set_bit(buffer->guards, buffer->length, guard);
+    }
+    buffer->length++;
+}
+
+/**
+ * Appends a module, the module is dropped if the buffer is full
+*/
+void module_buffer_append(ModuleBuffer* buffer, bool module) {
+    append_module(buffer, module, false);
+}
+
+/**
+ * Appends count modules of the same color
+*/
+void module_buffer_append_run(ModuleBuffer* buffer, bool module, size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        module_buffer_append(buffer, module);
+    }
+}
+
+/**
+ * Appends the lowest count bits of bits, msb first, like the patterns in the encoding tables
+*/
+void module_buffer_append_bits(ModuleBuffer* buffer, uint32_t bits, uint8_t count) {
+    while(count > 0) {
+        count--;
+        module_buffer_append(buffer, (bits >> count) & 1);
+    }
+}
+
+/**
+ * Appends the lowest count bits of bits like module_buffer_append_bits and marks them as a guard pattern
+*/
+void module_buffer_append_guard_bits(ModuleBuffer* buffer, uint32_t bits, uint8_t count) {
+    while(count > 0) {
+        count--;
+        append_module(buffer, (bits >> count) & 1, true);
+    }
+}
+
+/**
+ * Appends the modules of a string of 1's and 0's, like the ones in the encoding tables
+*/
+void module_buffer_append_str(ModuleBuffer* buffer, const char* bits) {
+    for(size_t i = 0; bits[i] != '\0'; i++) {
+        module_buffer_append(buffer, bits[i] == '1');
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "barcode_alloc.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//the number of bytes needed to store a number of modules
+#define MODULE_BUFFER_BYTES(modules) (((modules) + 7) / 8)
+
+/**
+ * A fixed size buffer of barcode modules, one bit per module
+ * A set bit is a bar (black module), a cleared bit is a space (white module)
+ * Modules are packed msb first, module 0 is bit 7 of the first byte
+ * Guards are packed the same way, a set bit marks a module of a guard pattern (EAN/UPC)
+*/
+typedef struct {
+    uint8_t* data; //the packed modules
+    uint8_t* guards; //the packed guard flags, NULL if the buffer doesn't keep them
+    size_t length; //the number of modules in the buffer
+    size_t capacity; //the number of modules that fit in data
+} ModuleBuffer;
+
+ModuleBuffer* module_buffer_alloc(size_t capacity);
+void module_buffer_free(ModuleBuffer* buffer);
+void module_buffer_init(
+    ModuleBuffer* buffer,
+    uint8_t* storage,
+    uint8_t* guard_storage,
+    size_t capacity);
+void module_buffer_reset(ModuleBuffer* buffer);
+size_t module_buffer_size(const ModuleBuffer* buffer);
+bool module_buffer_get(const ModuleBuffer* buffer, size_t index);
+bool module_buffer_is_guard(const ModuleBuffer* buffer, size_t index);
+void module_buffer_append(ModuleBuffer* buffer, bool module);
+void module_buffer_append_run(ModuleBuffer* buffer, bool module, size_t count);
+void module_buffer_append_bits(ModuleBuffer* buffer, uint32_t bits, uint8_t count);
+void module_buffer_append_guard_bits(ModuleBuffer* buffer, uint32_t bits, uint8_t count);
+void module_buffer_append_str(ModuleBuffer* buffer, const char* bits);
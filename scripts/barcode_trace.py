@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""
+Summarises the timing trace of the barcode app
+
+The trace is written to apps_data/barcodes/timing.bin when Up, Up, Down, Down are pressed in the barcode
+view, see barcode_trace.h for the format. Every stage is paired from its begin to its end point and the
+durations are summarised per stage and barcode type. The events of debug builds are summarised per event.
+
+usage: barcode_trace.py timing.bin [--points]
+"""
+
+import argparse
+import struct
+import sys
+
+HEADER = struct.Struct("<4sBBHI")
+POINT = struct.Struct("<IHBB")
+
+MAGIC = b"BCTR"
+VERSION = 1
+END = 0x80
+EVENT = 0x40
+NO_TYPE = 0xFF
+
+# the same order as BarcodeTraceStage and BarcodeType
+STAGES = ["select", "read_file", "encode", "runs", "draw", "save", "remove", "memory"]
+MEMORY = 7
+TYPES = ["UPC-A", "EAN-8", "EAN-13", "CODE-39", "CODE-128", "CODE-128C", "Codabar"]
+
+# the order of BarcodeDebugPhase, the type of the memory events
+PHASES = ["read_file", "validate", "encode", "first_draw"]
+
+
+def stage_name(stage):
+    return STAGES[stage] if stage < len(STAGES) else f"stage {stage}"
+
+
+def type_name(barcode_type, stage=None):
+    if stage == MEMORY:
+        return PHASES[barcode_type] if barcode_type < len(PHASES) else f"phase {barcode_type}"
+    if barcode_type == NO_TYPE:
+        return "-"
+    return TYPES[barcode_type] if barcode_type < len(TYPES) else f"type {barcode_type}"
+
+
+def read_trace(path):
+    with open(path, "rb") as file:
+        data = file.read()
+
+    magic, version, point_size, count, cycles_per_us = HEADER.unpack_from(data)
+    if magic != MAGIC or version != VERSION or point_size != POINT.size:
+        sys.exit(f"{path} is not a version {VERSION} barcode trace")
+
+    points = [
+        POINT.unpack_from(data, HEADER.size + i * POINT.size)
+        for i in range(min(count, (len(data) - HEADER.size) // POINT.size))
+    ]
+    return points, cycles_per_us
+
+
+def pair_stages(points, cycles_per_us):
+    """
+    Pairs every end point with the last begin point of the same stage, the draw stage runs on the GUI
+    thread so it can end up in between the points of the other stages
+    @returns the durations in us of every (stage, type) and the number of points without a pair
+    """
+    open_stages = {}
+    durations = {}
+    unpaired = 0
+    for cycles, length, stage, barcode_type in points:
+        if stage & EVENT:
+            continue
+        begins = open_stages.setdefault(stage & ~END, [])
+        if not stage & END:
+            begins.append(cycles)
+            continue
+        if not begins:
+            unpaired += 1
+            continue
+        # the cycle counter wraps, the difference is still right for stages shorter than the wrap
+        elapsed = (cycles - begins.pop()) & 0xFFFFFFFF
+        durations.setdefault((stage & ~END, barcode_type), []).append(
+            (elapsed / cycles_per_us, length)
+        )
+    unpaired += sum(len(begins) for begins in open_stages.values())
+    return durations, unpaired
+
+
+def summarise_events(points):
+    """
+    @returns the values of every (stage, type) of the events
+    """
+    events = {}
+    for _, length, stage, barcode_type in points:
+        if stage & EVENT:
+            events.setdefault((stage & ~EVENT, barcode_type), []).append(length)
+    return events
+
+
+def percentile(values, percent):
+    return values[min(len(values) - 1, len(values) * percent // 100)]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Summarises the timing trace of the barcode app")
+    parser.add_argument("trace", help="the timing.bin file")
+    parser.add_argument("--points", action="store_true", help="also print every trace point")
+    args = parser.parse_args()
+
+    points, cycles_per_us = read_trace(args.trace)
+    if args.points:
+        for cycles, length, stage, barcode_type in points:
+            kind = "event" if stage & EVENT else "end  " if stage & END else "begin"
+            stage &= ~(END | EVENT)
+            print(
+                f"{cycles:10d} {kind} {stage_name(stage):10s} "
+                f"{type_name(barcode_type, stage):10s} {length}"
+            )
+        print()
+
+    durations, unpaired = pair_stages(points, cycles_per_us)
+    print(f"{len(points)} points, {unpaired} without a pair, {cycles_per_us} cycles per us")
+    print(
+        f"{'stage':10s} {'type':10s} {'count':>6s} {'length':>7s} "
+        f"{'min us':>9s} {'p50 us':>9s} {'p95 us':>9s} {'max us':>9s}"
+    )
+    for (stage, barcode_type), samples in sorted(durations.items()):
+        times = sorted(time for time, _ in samples)
+        lengths = [length for _, length in samples]
+        print(
+            f"{stage_name(stage):10s} {type_name(barcode_type):10s} {len(times):6d} "
+            f"{max(lengths):7d} {times[0]:9.1f} {percentile(times, 50):9.1f} "
+            f"{percentile(times, 95):9.1f} {times[-1]:9.1f}"
+        )
+
+    events = summarise_events(points)
+    if events:
+        print()
+        print(f"{'event':10s} {'type':10s} {'count':>6s} {'min':>7s} {'p50':>7s} {'max':>7s}")
+    for (stage, barcode_type), values in sorted(events.items()):
+        values.sort()
+        print(
+            f"{stage_name(stage):10s} {type_name(barcode_type, stage):10s} {len(values):6d} "
+            f"{values[0]:7d} {percentile(values, 50):7d} {values[-1]:7d}"
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""
+Generates the Code 39, Codabar and Code 128 tables of encodings.c from barcode_encoding_files
+
+The .txt tables are the source of the encodings, the arrays in encodings.c are generated from them so the two
+can't drift apart. The EAN/UPC tables are not in the .txt files and are left as they are.
+
+usage: gen_encodings.py [--check]
+  --check  only compare encodings.c with the .txt files, exits with 1 if they differ
+"""
+
+import argparse
+import difflib
+import os
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+TABLES = os.path.join(ROOT, "barcode_encoding_files")
+ENCODINGS_C = os.path.join(ROOT, "encodings.c")
+
+# the .txt files write '#' as H# because # starts a comment in them
+ESCAPES = {"H#": "#"}
+
+# the stop codeword is not in code128_encodings.txt, it is the only pattern with 13 modules
+CODE_128_STOP = "1100011101011"
+CODE_128_NAMES = {103: "START A", 104: "START B", 105: "START C", 106: "STOP"}
+
+
+def read_table(name):
+    """
+    @returns the sections of a table file, a list of (key, value) per section, sections are separated by
+    an empty line
+    """
+    sections = [[]]
+    with open(os.path.join(TABLES, name)) as file:
+        for line in file.read().split("\n"):
+            if line.startswith("# "):
+                continue
+            if line == "":
+                if sections[-1]:
+                    sections.append([])
+                continue
+            key, value = line.split(": ", 1)
+            sections[-1].append((ESCAPES.get(key, key), value))
+    return [section for section in sections if section]
+
+
+def c_char(character):
+    return "'\\''" if character == "'" else "'\\\\'" if character == "\\" else f"'{character}'"
+
+
+def elements_array(name, table):
+    lines = [f"const char* const {name}[128] = {{"]
+    lines += [f'    [{c_char(key)}] = "{value}",' for key, value in table]
+    lines[-1] = lines[-1][:-1] + "};"
+    return "\n".join(lines)
+
+
+def code_128_patterns():
+    characters, encodings = read_table("code128_encodings.txt")
+    # the second section starts with its name
+    encodings = [(key, value) for key, value in encodings if key != "ENCODINGS"]
+    patterns = [value for _, value in encodings]
+    if [int(key) for key, _ in encodings] != list(range(len(patterns))):
+        sys.exit("code128_encodings.txt: the ENCODINGS are not in codeword order")
+
+    # every character of set B is the codeword of its ascii code - 32, the encoder relies on that
+    for key, value in characters:
+        if int(value) != ord(key) - 32:
+            sys.exit(f"code128_encodings.txt: {key!r} is not codeword {ord(key) - 32}")
+
+    # the set C table repeats the codewords 0-99
+    for key, value in read_table("code128c_encodings.txt")[0]:
+        if patterns[int(key)] != value:
+            sys.exit(f"code128c_encodings.txt: {key} differs from codeword {int(key)} of Code 128")
+
+    patterns.append(CODE_128_STOP)
+    lines = ["const uint16_t CODE_128_PATTERNS[107] = {"]
+    for value, pattern in enumerate(patterns):
+        comment = f"{value} {pattern}"
+        if value in CODE_128_NAMES:
+            comment += " " + CODE_128_NAMES[value]
+        separator = "," if value < len(patterns) - 1 else ""
+        lines.append(f"    0x{int(pattern, 2):04X}{separator} // {comment}")
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def replace_array(source, array):
+    """
+    Replaces the array in source that has the same declaration as the first line of array
+    """
+    declaration = array.split("\n", 1)[0]
+    start = source.index(declaration)
+    end = source.index("};", start) + 2
+    return source[:start] + array + source[end:]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generates the encoding tables of encodings.c")
+    parser.add_argument(
+        "--check", action="store_true", help="only check that encodings.c matches the .txt files"
+    )
+    args = parser.parse_args()
+
+    with open(ENCODINGS_C) as file:
+        current = file.read()
+
+    generated = current
+    generated = replace_array(
+        generated, elements_array("CODE_39_ENCODINGS", read_table("code39_encodings.txt")[0])
+    )
+    generated = replace_array(
+        generated, elements_array("CODABAR_ENCODINGS", read_table("codabar_encodings.txt")[0])
+    )
+    generated = replace_array(generated, code_128_patterns())
+
+    if generated == current:
+        return
+    if args.check:
+        sys.stdout.writelines(
+            difflib.unified_diff(
+                current.splitlines(True), generated.splitlines(True), "encodings.c", "generated"
+            )
+        )
+        sys.exit(1)
+    with open(ENCODINGS_C, "w") as file:
+        file.write(generated)
+    print("encodings.c was updated")
+
+
+if __name__ == "__main__":
+    main()
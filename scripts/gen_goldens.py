@@ -0,0 +1,302 @@
+#!/usr/bin/env python3
+"""
+Generates the golden PBM images of the barcodes in barcode_goldens.h into golden_bars
+
+This is a reference encoder that only uses barcode_encoding_files and the EAN/UPC and Code 128
+specifications, it shares no code or tables with the encoder of the app. The images only have the bars and
+the guard bars at the place the barcode view draws them, the text under the bars depends on the fonts of
+the firmware and is not checked.
+
+usage: gen_goldens.py [--check]
+  --check  only compare golden_bars with the generated images, exits with 1 if they differ
+"""
+
+import argparse
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+TABLES = os.path.join(ROOT, "barcode_encoding_files")
+GOLDEN_BARS = os.path.join(ROOT, "golden_bars")
+
+WIDTH = 128
+HEIGHT = 64
+
+# the EAN/UPC L-codes of the specification, the R-codes are the L-codes inverted and the G-codes are the
+# R-codes reversed
+EAN_L_CODES = [
+    "0001101",
+    "0011001",
+    "0010011",
+    "0111101",
+    "0100011",
+    "0110001",
+    "0101111",
+    "0111011",
+    "0110111",
+    "0001011",
+]
+EAN_13_PARITY = [
+    "LLLLLL",
+    "LLGLGG",
+    "LLGGLG",
+    "LLGGGL",
+    "LGLLGG",
+    "LGGLLG",
+    "LGGGLL",
+    "LGLGLG",
+    "LGLGGL",
+    "LGGLGL",
+]
+EAN_START = "101"
+EAN_MIDDLE = "01010"
+EAN_END = "101"
+
+# the Code 128 stop pattern of the specification, it is not in code128_encodings.txt
+CODE_128_STOP = "1100011101011"
+CODE_128_START = {"A": 103, "B": 104, "C": 105}
+CODE_128_SWITCH = {"A": 101, "B": 100, "C": 99}
+
+# the app prints wide elements 3 modules wide, the widest ratio the specifications allow, and a narrow
+# space after every character
+WIDE = 3
+
+
+def read_table(name):
+    """
+    @returns the sections of a table file, a list of (key, value) per section, sections are separated by
+    an empty line
+    """
+    sections = [[]]
+    with open(os.path.join(TABLES, name)) as file:
+        for line in file.read().split("\n"):
+            if line.startswith("# "):
+                continue
+            if line == "":
+                if sections[-1]:
+                    sections.append([])
+                continue
+            key, value = line.split(": ", 1)
+            # the files write '#' as H# because # starts a comment in them
+            sections[-1].append(("#" if key == "H#" else key, value))
+    return [section for section in sections if section]
+
+
+def read_defines(name):
+    """
+    @returns the integer #defines of a header, the defines may use the defines above them
+    """
+    defines = {}
+    with open(os.path.join(ROOT, name)) as file:
+        for match in re.finditer(r"^#define (\w+) ([\w +*/()-]+)$", file.read(), re.M):
+            expression = match.group(2)
+            for key, value in defines.items():
+                expression = re.sub(rf"\b{key}\b", str(value), expression)
+            if re.fullmatch(r"[\d +*/()-]+", expression):
+                defines[match.group(1)] = eval(expression)
+    return defines
+
+
+def read_types():
+    """
+    @returns the start_pos of every barcode type by its name, from the BARCODE_TYPES of barcode_types.h
+    """
+    with open(os.path.join(ROOT, "barcode_types.h")) as file:
+        return {
+            name: int(start_pos)
+            for name, start_pos in re.findall(
+                r'X\(\w+, "([^"]+)", -?\d+, -?\d+, (-?\d+),', file.read()
+            )
+        }
+
+
+def read_goldens():
+    """
+    @returns the (type, data, name) of every golden barcode of barcode_goldens.h
+    """
+    with open(os.path.join(ROOT, "barcode_goldens.h")) as file:
+        text = file.read()
+    string = r'"((?:[^"\\]|\\.)*)"'
+    return [
+        tuple(bytes(value, "ascii").decode("unicode_escape") for value in golden)
+        for golden in re.findall(rf"X\({string}, {string}, {string}\)", text)
+    ]
+
+
+def ean_check_digit(digits):
+    weights = [3 if i % 2 == 0 else 1 for i in range(len(digits))]
+    total = sum(int(digit) * weight for digit, weight in zip(reversed(digits), weights))
+    return str((10 - total % 10) % 10)
+
+
+def ean_upc(digit_count, data):
+    """
+    @returns the modules and which of them are guard modules, the check digit is always calculated
+    """
+    digits = data[: digit_count - 1]
+    digits += ean_check_digit(digits)
+
+    if digit_count == 13:
+        parity = EAN_13_PARITY[int(digits[0])]
+        digits = digits[1:]
+    else:
+        parity = "L" * (len(digits) // 2)
+    half = len(digits) // 2
+
+    def code(digit, kind):
+        l_code = EAN_L_CODES[int(digit)]
+        r_code = "".join("1" if module == "0" else "0" for module in l_code)
+        return {"L": l_code, "R": r_code, "G": r_code[::-1]}[kind]
+
+    parts = [(EAN_START, True)]
+    parts += [(code(digit, kind), False) for digit, kind in zip(digits[:half], parity)]
+    parts += [(EAN_MIDDLE, True)]
+    parts += [(code(digit, "R"), False) for digit in digits[half:]]
+    parts += [(EAN_END, True)]
+    modules = "".join(part for part, _ in parts)
+    guards = "".join(("1" if guard else "0") * len(part) for part, guard in parts)
+    return modules, guards
+
+
+def wide_narrow(table, characters):
+    modules = ""
+    for character in characters:
+        for i, element in enumerate(table[character]):
+            modules += ("1" if i % 2 == 0 else "0") * (WIDE if element == "1" else 1)
+        modules += "0"
+    return modules
+
+
+def code_128_codewords(data, sets):
+    """
+    @returns the fewest codewords that encode the data with the start codeword of one of the sets
+    Every character is encoded in set A, B or C (two digits) and changing the set costs a codeword
+    Of the encodings with the fewest codewords the one that stays in its set the longest is used, then
+    set B before A before C, like the start codewords of annex E of the specification
+    """
+    set_b = {key: int(value) for key, value in read_table("code128_encodings.txt")[0]}
+    # set B has DEL at 95, set A has the ascii codes 32-95 at 0-63 and the control characters at 64-95
+    set_b["\x7f"] = 95
+
+    def value(code_set, position):
+        character = data[position]
+        if code_set == "C":
+            pair = data[position : position + 2]
+            return int(pair) if len(pair) == 2 and pair.isdigit() else None
+        if code_set == "B":
+            return set_b.get(character)
+        if ord(character) < 32:
+            return ord(character) + 64
+        return ord(character) - 32 if ord(character) < 96 else None
+
+    # best[position][set] = the codewords of the rest of the data when the set is active at the position
+    best = [{} for _ in range(len(data) + 1)]
+    for code_set in "ABC":
+        best[len(data)][code_set] = []
+    for position in range(len(data) - 1, -1, -1):
+        for code_set in "ABC":
+            options = []
+            for next_set in code_set + "BAC".replace(code_set, ""):
+                codeword = value(next_set, position)
+                if codeword is None:
+                    continue
+                step = 2 if next_set == "C" else 1
+                switch = [] if next_set == code_set else [CODE_128_SWITCH[next_set]]
+                options.append(switch + [codeword] + best[position + step][next_set])
+            best[position][code_set] = min(options, key=len)
+
+    starts = [code_set for code_set in "BAC" if code_set in sets]
+    start = min(starts, key=lambda code_set: len(best[0][code_set]))
+    return [CODE_128_START[start]] + best[0][start]
+
+
+def code_128(data, sets):
+    patterns = [value for key, value in read_table("code128_encodings.txt")[1] if key != "ENCODINGS"]
+    codewords = code_128_codewords(data, sets)
+    check = (codewords[0] + sum(i * codeword for i, codeword in enumerate(codewords[1:], 1))) % 103
+    return "".join(patterns[codeword] for codeword in codewords + [check]) + CODE_128_STOP
+
+
+def modules_of(type_name, data):
+    """
+    @returns the modules of a barcode and its guard modules, None for the types without guards
+    """
+    if type_name in ("UPC-A", "EAN-8", "EAN-13"):
+        return ean_upc({"UPC-A": 12, "EAN-8": 8, "EAN-13": 13}[type_name], data)
+    if type_name == "CODE-39":
+        table = dict(read_table("code39_encodings.txt")[0])
+        text = data.upper()
+        if not text.startswith("*"):
+            text = "*" + text
+        if not text.endswith("*") or len(text) == 1:
+            text += "*"
+        return wide_narrow(table, text), None
+    if type_name == "Codabar":
+        table = dict(read_table("codabar_encodings.txt")[0])
+        return wide_narrow(table, data.upper()), None
+    if type_name == "CODE-128":
+        return code_128(data, "ABC"), None
+    if type_name == "CODE-128C":
+        return code_128(data, "C"), None
+    sys.exit(f"no reference encoder for {type_name}")
+
+
+def pbm(type_name, data, start_positions, defines):
+    """
+    @returns the binary PBM image of the bars the barcode view draws for the barcode
+    """
+    modules, guards = modules_of(type_name, data)
+    if guards is not None:
+        x = start_positions[type_name]
+    else:
+        # centered, the division of the app rounds towards zero
+        x = int((WIDTH - len(modules)) / 2)
+
+    y_start = defines["BARCODE_Y_START"]
+    bars_end = y_start + defines["BARCODE_HEIGHT"]
+    guards_end = y_start + defines["BARCODE_GUARD_HEIGHT"]
+
+    rows = bytearray(WIDTH // 8 * HEIGHT)
+    for y in range(y_start, guards_end):
+        for i, module in enumerate(modules):
+            bar = module == "1" and (y < bars_end or (guards is not None and guards[i] == "1"))
+            if bar and 0 <= x + i < WIDTH:
+                rows[y * WIDTH // 8 + (x + i) // 8] |= 0x80 >> ((x + i) % 8)
+    return f"P4\n{WIDTH} {HEIGHT}\n".encode() + bytes(rows)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generates the golden PBM images of the barcodes")
+    parser.add_argument(
+        "--check", action="store_true", help="only check that golden_bars matches the generated images"
+    )
+    args = parser.parse_args()
+
+    defines = read_defines("barcode_app.h")
+    start_positions = read_types()
+
+    differs = []
+    os.makedirs(GOLDEN_BARS, exist_ok=True)
+    for type_name, data, name in read_goldens():
+        path = os.path.join(GOLDEN_BARS, name + ".pbm")
+        image = pbm(type_name, data, start_positions, defines)
+        current = None
+        if os.path.exists(path):
+            with open(path, "rb") as file:
+                current = file.read()
+        if current == image:
+            continue
+        differs.append(path)
+        if not args.check:
+            with open(path, "wb") as file:
+                file.write(image)
+
+    for path in differs:
+        print(f"{os.path.relpath(path, ROOT)} {'differs' if args.check else 'was updated'}")
+    if args.check and differs:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -2,434 +2,407 @@
 #include "barcode_view.h"
 #include "../encodings.h"
 
+//debug builds count every canvas call the barcode view makes to measure what a frame costs
+#ifdef BARCODE_DEBUG
+#define barcode_canvas_count(call) barcode_debug_canvas_call(call)
+#else
+#define barcode_canvas_count(call)
+#endif
+
 /**
- * @brief Draws a single bit from a barcode at a specified location
- * @param canvas 
- * @param bit  a 1 or a 0 to signify a bit of data
- * @param x  the top left x coordinate
- * @param y  the top left y coordinate
- * @param width  the width of the bit
- * @param height  the height of the bit
- */
-static void draw_bit(Canvas* canvas, int bit, int x, int y, int width, int height) {
-    if(bit == 1) {
-        canvas_set_color(canvas, ColorBlack);
-    } else {
-        canvas_set_color(canvas, ColorWhite);
-    }
+ * The canvas functions the barcode view draws with, they are the canvas functions of the firmware
+ * and count the call in debug builds
+*/
+static void barcode_canvas_clear(Canvas* canvas) {
+    barcode_canvas_count(BarcodeDebugCanvasClear);
+    canvas_clear(canvas);
+}
+
+static void barcode_canvas_set_color(Canvas* canvas, Color color) {
+    barcode_canvas_count(BarcodeDebugCanvasSetColor);
+    canvas_set_color(canvas, color);
+}
+
+static void barcode_canvas_set_font(Canvas* canvas, Font font) {
+    barcode_canvas_count(BarcodeDebugCanvasSetFont);
+    canvas_set_font(canvas, font);
+}
+
+static void
+    barcode_canvas_draw_box(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height) {
+    barcode_canvas_count(BarcodeDebugCanvasDrawBox);
     canvas_draw_box(canvas, x, y, width, height);
 }
 
+static void barcode_canvas_draw_str(Canvas* canvas, int32_t x, int32_t y, const char* str) {
+    barcode_canvas_count(BarcodeDebugCanvasDrawStr);
+    canvas_draw_str(canvas, x, y, str);
+}
+
+static void barcode_canvas_draw_str_aligned(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    Align horizontal,
+    Align vertical,
+    const char* str) {
+    barcode_canvas_count(BarcodeDebugCanvasDrawStr);
+    canvas_draw_str_aligned(canvas, x, y, horizontal, vertical, str);
+}
+
+static void barcode_canvas_draw_xbm(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap) {
+    barcode_canvas_count(BarcodeDebugCanvasDrawXbm);
+    canvas_draw_xbm(canvas, x, y, width, height, bitmap);
+}
+
+static void barcode_canvas_multiline_text(
+    Canvas* canvas,
+    int32_t x,
+    int32_t y,
+    Align horizontal,
+    Align vertical,
+    const char* text) {
+    barcode_canvas_count(BarcodeDebugCanvasMultilineText);
+    elements_multiline_text_aligned(canvas, x, y, horizontal, vertical, text);
+}
+
 /**
  * Draws the error name and message on the screen
 */
 static void draw_error_str(Canvas* canvas, const char* title, const char* error) {
-    canvas_clear(canvas);
-    elements_multiline_text_aligned(canvas, 0, 0, AlignLeft, AlignTop, title);
-    elements_multiline_text_aligned(canvas, 0, 12, AlignLeft, AlignTop, error);
+    barcode_canvas_clear(canvas);
+    barcode_canvas_multiline_text(canvas, 0, 0, AlignLeft, AlignTop, title);
+    barcode_canvas_multiline_text(canvas, 0, 12, AlignLeft, AlignTop, error);
 }
 
 /**
- * @param bits  a string of 1's and 0's
- * @returns the x coordinate after the bits have been drawn, useful for drawing the next section of bits
+ * Draws the bars of a barcode with one canvas box per bar
+ * The spaces are skipped since the canvas is already cleared
 */
-static int draw_bits(Canvas* canvas, const char* bits, int x, int y, int width, int height) {
-    int bits_length = strlen(bits);
-    for(int i = 0; i < bits_length; i++) {
-        char c = bits[i];
-        int num = c - '0';
-
-        draw_bit(canvas, num, x, y, width, height);
-
+static void draw_runs(Canvas* canvas, const BarcodeData* barcode_data, const BarcodeRender* render) {
+    const BarcodeRuns* runs = &barcode_data->runs;
+    int x = render->x;
+
+    barcode_canvas_set_color(canvas, ColorBlack);
+    for(size_t i = 0; i < runs->count; i++) {
+        int width = runs->widths[i] & BARCODE_RUN_WIDTH_MASK;
+
+        //even runs are bars, odd runs are spaces
+        if((i & 1) == 0 && width > 0) {
+            bool guard = runs->widths[i] & BARCODE_RUN_GUARD;
+            barcode_canvas_draw_box(
+                canvas,
+                x,
+                BARCODE_Y_START,
+                width,
+                guard ? BARCODE_GUARD_HEIGHT : BARCODE_HEIGHT);
+        }
         x += width;
     }
-    return x;
 }
 
 /**
- * Draws an EAN-8 type barcode, does not check if the barcode is valid
- * @param canvas  the canvas
- * @param barcode_digits  the digits in the barcode, must be 8 characters long
+ * Draws the bars of a barcode by copying the cached row bitmap into every row of the bars
 */
-static void draw_ean_8(Canvas* canvas, BarcodeData* barcode_data) {
-    FuriString* barcode_digits = barcode_data->correct_data;
-    BarcodeTypeObj* type_obj = barcode_data->type_obj;
+static void draw_row_bitmap(Canvas* canvas, const BarcodeData* barcode_data, const BarcodeRender* render) {
+    UNUSED(barcode_data);
 
-    int barcode_length = furi_string_size(barcode_digits);
-
-    int x = type_obj->start_pos;
+    barcode_canvas_set_color(canvas, ColorBlack);
     int y = BARCODE_Y_START;
-    int width = 1;
-    int height = BARCODE_HEIGHT;
-
-    //the guard patterns for the beginning, center, ending
-    const char* end_bits = "101";
-    const char* center_bits = "01010";
-
-    //draw the starting guard pattern
-    x = draw_bits(canvas, end_bits, x, y, width, height + 5);
-
-    FuriString* code_part = furi_string_alloc();
-
-    //loop through each digit, find the encoding, and draw it
-    for(int i = 0; i < barcode_length; i++) {
-        char current_digit = furi_string_get_char(barcode_digits, i);
-
-        //the actual number and the index of the bits
-        int index = current_digit - '0';
-        //use the L-codes for the first 4 digits and the R-Codes for the last 4 digits
-        if(i <= 3) {
-            furi_string_set_str(code_part, UPC_EAN_L_CODES[index]);
-        } else {
-            furi_string_set_str(code_part, UPC_EAN_R_CODES[index]);
-        }
-
-        //convert the current_digit char into a string so it can be printed
-        char current_digit_string[2];
-        snprintf(current_digit_string, 2, "%c", current_digit);
-
-        //set the canvas color to black to print the digit
-        canvas_set_color(canvas, ColorBlack);
-        canvas_draw_str(canvas, x + 1, y + height + 8, current_digit_string);
-
-        //draw the bits of the barcode
-        x = draw_bits(canvas, furi_string_get_cstr(code_part), x, y, width, height);
+    for(; y < BARCODE_Y_START + BARCODE_HEIGHT; y++) {
+        barcode_canvas_draw_xbm(canvas, 0, y, 128, 1, render->row);
+    }
 
-        //if the index has reached 3, that means 4 digits have been drawn and now draw the center guard pattern
-        if(i == 3) {
-            x = draw_bits(canvas, center_bits, x, y, width, height + 5);
+    //the guard bars extend below the rest of the bars
+    if(render->has_guards) {
+        for(; y < BARCODE_Y_START + BARCODE_GUARD_HEIGHT; y++) {
+            barcode_canvas_draw_xbm(canvas, 0, y, 128, 1, render->guard_row);
         }
     }
-    furi_string_free(code_part);
-
-    //draw the ending guard pattern
-    x = draw_bits(canvas, end_bits, x, y, width, height + 5);
 }
 
-static void draw_ean_13(Canvas* canvas, BarcodeData* barcode_data) {
-    FuriString* barcode_digits = barcode_data->correct_data;
-    BarcodeTypeObj* type_obj = barcode_data->type_obj;
-
-    int barcode_length = furi_string_size(barcode_digits);
-
-    int x = type_obj->start_pos;
-    int y = BARCODE_Y_START;
-    int width = 1;
-    int height = BARCODE_HEIGHT;
-
-    //the guard patterns for the beginning, center, ending
-    const char* end_bits = "101";
-    const char* center_bits = "01010";
-
-    //draw the starting guard pattern
-    x = draw_bits(canvas, end_bits, x, y, width, height + 5);
-
-    FuriString* left_structure = furi_string_alloc();
-    FuriString* code_part = furi_string_alloc();
-
-    //loop through each digit, find the encoding, and draw it
-    for(int i = 0; i < barcode_length; i++) {
-        char current_digit = furi_string_get_char(barcode_digits, i);
-        int index = current_digit - '0';
-
-        if(i == 0) {
-            furi_string_set_str(left_structure, EAN_13_STRUCTURE_CODES[index]);
-
-            //convert the current_digit char into a string so it can be printed
-            char current_digit_string[2];
-            snprintf(current_digit_string, 2, "%c", current_digit);
+/**
+ * Draws the bars of a barcode
+*/
+typedef void (*BarsRenderer)(
+    Canvas* canvas,
+    const BarcodeData* barcode_data,
+    const BarcodeRender* render);
 
-            //set the canvas color to black to print the digit
-            canvas_set_color(canvas, ColorBlack);
-            canvas_draw_str(canvas, x - 10, y + height + 8, current_digit_string);
+static const BarsRenderer bars_renderers[] = {
+    [BarcodeRendererBoxes] = draw_runs,
+    [BarcodeRendererRowBitmap] = draw_row_bitmap,
+};
 
-            continue;
-        } else {
-            //use the L-codes for the first 6 digits and the R-Codes for the last 6 digits
-            if(i <= 6) {
-                //get the encoding type at the current barcode bit position
-                char encoding_type = furi_string_get_char(left_structure, i - 1);
-                if(encoding_type == 'L') {
-                    furi_string_set_str(code_part, UPC_EAN_L_CODES[index]);
-                } else {
-                    furi_string_set_str(code_part, EAN_G_CODES[index]);
+/**
+ * Builds a single row of the barcode as an xbm bitmap, every row of a 1D barcode is the same
+ * Also builds a row of only the guard bars, which extend below the rest of the bars
+*/
+static void build_row_bitmaps(BarcodeRender* render, const BarcodeRuns* runs) {
+    int x = render->x;
+
+    memset(render->row, 0, BARCODE_ROW_BYTES);
+    memset(render->guard_row, 0, BARCODE_ROW_BYTES);
+    render->has_guards = false;
+
+    for(size_t i = 0; i < runs->count; i++) {
+        int width = runs->widths[i] & BARCODE_RUN_WIDTH_MASK;
+
+        //even runs are bars, odd runs are spaces
+        if((i & 1) == 0) {
+            bool guard = runs->widths[i] & BARCODE_RUN_GUARD;
+            render->has_guards |= guard;
+
+            //parts of the barcode that are off the screen are cut off
+            for(int pixel = MAX(x, 0); pixel < MIN(x + width, 128); pixel++) {
+                //xbm bitmaps store the leftmost pixel in the least significant bit
+                render->row[pixel >> 3] |= 1 << (pixel & 7);
+                if(guard) {
+                    render->guard_row[pixel >> 3] |= 1 << (pixel & 7);
                 }
-            } else {
-                furi_string_set_str(code_part, UPC_EAN_R_CODES[index]);
-            }
-
-            //convert the current_digit char into a string so it can be printed
-            char current_digit_string[2];
-            snprintf(current_digit_string, 2, "%c", current_digit);
-
-            //set the canvas color to black to print the digit
-            canvas_set_color(canvas, ColorBlack);
-            canvas_draw_str(canvas, x + 1, y + height + 8, current_digit_string);
-
-            //draw the bits of the barcode
-            x = draw_bits(canvas, furi_string_get_cstr(code_part), x, y, width, height);
-
-            //if the index has reached 6, that means 6 digits have been drawn and we now draw the center guard pattern
-            if(i == 6) {
-                x = draw_bits(canvas, center_bits, x, y, width, height + 5);
             }
         }
+        x += width;
     }
-
-    furi_string_free(left_structure);
-    furi_string_free(code_part);
-
-    //draw the ending guard pattern
-    x = draw_bits(canvas, end_bits, x, y, width, height + 5);
 }
 
 /**
- * Draw a UPC-A barcode
+ * Adds a digit that is drawn underneath an EAN/UPC barcode to the render
+ * @param x  the x coordinate of the digit
 */
-static void draw_upc_a(Canvas* canvas, BarcodeData* barcode_data) {
-    FuriString* barcode_digits = barcode_data->correct_data;
-    BarcodeTypeObj* type_obj = barcode_data->type_obj;
-
-    int barcode_length = furi_string_size(barcode_digits);
-
-    int x = type_obj->start_pos;
-    int y = BARCODE_Y_START;
-    int width = 1;
-    int height = BARCODE_HEIGHT;
-
-    //the guard patterns for the beginning, center, ending
-    char* end_bits = "101";
-    char* center_bits = "01010";
-
-    //draw the starting guard pattern
-    x = draw_bits(canvas, end_bits, x, y, width, height + 5);
+static void add_digit(BarcodeRender* render, char digit, int x) {
+    BarcodeRenderDigit* render_digit = &render->digits[render->digit_count++];
+    render_digit->x = x;
+    render_digit->text[0] = digit;
+    render_digit->text[1] = '\0';
+}
 
-    FuriString* code_part = furi_string_alloc();
+/**
+ * Lays out the digits under an EAN-8, EAN-13, or UPC-A barcode
+ * @param render  the render, x must already be set
+ * @param barcode_data  the barcode data, correct_data must have all of the layout's digits
+*/
+static void layout_ean_upc(BarcodeRender* render, BarcodeData* barcode_data, const EanUpcLayout* layout) {
+    const char* barcode_digits = furi_string_get_cstr(barcode_data->correct_data);
 
-    //loop through each digit, find the encoding, and draw it
-    for(int i = 0; i < barcode_length; i++) {
-        char current_digit = furi_string_get_char(barcode_digits, i);
-        int index = current_digit - '0'; //convert the number into an int (also the index)
+    //skip the starting guard pattern
+    int x = render->x + 3;
 
-        //use the L-codes for the first 6 digits and the R-Codes for the last 6 digits
-        if(i <= 5) {
-            furi_string_set_str(code_part, UPC_EAN_L_CODES[index]);
-        } else {
-            furi_string_set_str(code_part, UPC_EAN_R_CODES[index]);
+    //loop through each digit and place it under its bars
+    for(int i = 0; i < layout->digit_count; i++) {
+        //the first digit of EAN-13 has no bars, it is drawn left of the barcode
+        if(i < layout->first_digit) {
+            add_digit(render, barcode_digits[i], x - 10);
+            continue;
         }
 
-        //convert the current_digit char into a string so it can be printed
-        char current_digit_string[2];
-        snprintf(current_digit_string, 2, "%c", current_digit);
-
-        //set the canvas color to black to print the digit
-        canvas_set_color(canvas, ColorBlack);
-        canvas_draw_str(canvas, x + 1, y + height + 8, current_digit_string);
-
-        //draw the bits of the barcode
-        x = draw_bits(canvas, furi_string_get_cstr(code_part), x, y, width, height);
+        add_digit(render, barcode_digits[i], x + 1);
+        x += EAN_UPC_DIGIT_MODULES;
 
-        //if the index has reached 6, that means 6 digits have been drawn and we now draw the center guard pattern
-        if(i == 5) {
-            x = draw_bits(canvas, center_bits, x, y, width, height + 5);
+        //all of the left digits have been placed, skip the center guard pattern
+        if(i - layout->first_digit == layout->left_digits - 1) {
+            x += 5;
         }
     }
-
-    furi_string_free(code_part);
-
-    //draw the ending guard pattern
-    x = draw_bits(canvas, end_bits, x, y, width, height + 5);
 }
 
-static void draw_code_39(Canvas* canvas, BarcodeData* barcode_data) {
-    FuriString* raw_data = barcode_data->raw_data;
-    FuriString* barcode_digits = barcode_data->correct_data;
-    //BarcodeTypeObj* type_obj = barcode_data->type_obj;
+/**
+ * Does all of the layout work for a valid barcode, this only has to be done once per barcode
+*/
+static void build_render(BarcodeRender* render, BarcodeData* barcode_data) {
+    render->digit_count = 0;
 
-    int barcode_length = furi_string_size(barcode_digits);
-    int total_pixels = 0;
+    const EanUpcLayout* layout = barcode_data->type_obj->layout;
+    if(layout != NULL) {
+        render->x = barcode_data->type_obj->start_pos;
+        layout_ean_upc(render, barcode_data, layout);
+    } else {
+        //barcodes without guard patterns are drawn in the center of the screen with their data underneath
+        render->x = (128 - barcode_data->runs.total_width) / 2;
+    }
 
-    for(int i = 0; i < barcode_length; i++) {
-        //1 for wide, 0 for narrow
-        char wide_or_narrow = furi_string_get_char(barcode_digits, i);
-        int wn_digit = wide_or_narrow - '0'; //wide(1) or narrow(0) digit
+    build_row_bitmaps(render, &barcode_data->runs);
 
-        if(wn_digit == 1) {
-            total_pixels += 3;
-        } else {
-            total_pixels += 1;
-        }
-        if((i + 1) % 9 == 0) {
-            total_pixels += 1;
-        }
-    }
+    render->ready = true;
+}
 
-    int x = (128 - total_pixels) / 2;
-    int y = BARCODE_Y_START;
-    int width = 1;
-    int height = BARCODE_HEIGHT;
-    bool filled_in = true;
-
-    //set the canvas color to black to print the digit
-    canvas_set_color(canvas, ColorBlack);
-    // canvas_draw_str_aligned(canvas, 62, 30, AlignCenter, AlignCenter, error);
-    canvas_draw_str_aligned(
-        canvas, 62, y + height + 8, AlignCenter, AlignBottom, furi_string_get_cstr(raw_data));
-
-    for(int i = 0; i < barcode_length; i++) {
-        //1 for wide, 0 for narrow
-        char wide_or_narrow = furi_string_get_char(barcode_digits, i);
-        int wn_digit = wide_or_narrow - '0'; //wide(1) or narrow(0) digit
-
-        if(filled_in) {
-            if(wn_digit == 1) {
-                x = draw_bits(canvas, "111", x, y, width, height);
-            } else {
-                x = draw_bits(canvas, "1", x, y, width, height);
-            }
-            filled_in = false;
-        } else {
-            if(wn_digit == 1) {
-                x = draw_bits(canvas, "000", x, y, width, height);
-            } else {
-                x = draw_bits(canvas, "0", x, y, width, height);
-            }
-            filled_in = true;
-        }
-        if((i + 1) % 9 == 0) {
-            x = draw_bits(canvas, "0", x, y, width, height);
-            filled_in = true;
+/**
+ * Draws the text underneath the barcode
+*/
+static void draw_render_text(Canvas* canvas, BarcodeData* barcode_data, const BarcodeRender* render) {
+    barcode_canvas_set_color(canvas, ColorBlack);
+
+    if(render->digit_count > 0) {
+        for(int i = 0; i < render->digit_count; i++) {
+            barcode_canvas_draw_str(
+                canvas,
+                render->digits[i].x,
+                BARCODE_Y_START + BARCODE_HEIGHT + 8,
+                render->digits[i].text);
         }
+    } else {
+        barcode_canvas_draw_str_aligned(
+            canvas,
+            62,
+            BARCODE_Y_START + BARCODE_HEIGHT + 8,
+            AlignCenter,
+            AlignBottom,
+            furi_string_get_cstr(barcode_data->correct_data));
     }
 }
 
-static void draw_code_128(Canvas* canvas, BarcodeData* barcode_data) {
-    FuriString* raw_data = barcode_data->raw_data;
-    FuriString* barcode_digits = barcode_data->correct_data;
-
-    int barcode_length = furi_string_size(barcode_digits);
-
-    int x = (128 - barcode_length) / 2;
-    int y = BARCODE_Y_START;
-    int width = 1;
-    int height = BARCODE_HEIGHT;
-
-    x = draw_bits(canvas, furi_string_get_cstr(barcode_digits), x, y, width, height);
+#ifdef BARCODE_DEBUG
+/**
+ * Draws the draw time of the frame, the longest draw time of the last frames and the number of frames
+ * in the top right corner, over the top rows of the bars: the bars keep the rest of their height so the
+ * barcode still scans, and the text under the bars stays readable
+ * @param cycles  the cycles it took to draw the frame without the overlay
+*/
+static void draw_overlay(Canvas* canvas, BarcodeOverlay* overlay, uint32_t cycles) {
+    uint32_t frame_us = cycles / furi_hal_cortex_instructions_per_microsecond();
+    overlay->redraws++;
+    overlay->frame_us[overlay->redraws % BARCODE_OVERLAY_FRAMES] = frame_us;
+
+    uint32_t max_us = 0;
+    for(int i = 0; i < BARCODE_OVERLAY_FRAMES; i++) {
+        max_us = MAX(max_us, overlay->frame_us[i]);
+    }
 
-    //set the canvas color to black to print the digit
-    canvas_set_color(canvas, ColorBlack);
-    // canvas_draw_str_aligned(canvas, 62, 30, AlignCenter, AlignCenter, error);
-    canvas_draw_str_aligned(
-        canvas, 62, y + height + 8, AlignCenter, AlignBottom, furi_string_get_cstr(raw_data));
+    //three 10 digit numbers, a slash, "us" and a space
+    char text[36];
+    snprintf(
+        text,
+        sizeof(text),
+        "%lu/%luus %lu",
+        (unsigned long)frame_us,
+        (unsigned long)max_us,
+        (unsigned long)overlay->redraws);
+
+    barcode_canvas_set_font(canvas, FontBatteryPercent);
+    int width = canvas_string_width(canvas, text) + 1;
+    int height = canvas_current_font_height(canvas) + 1;
+    barcode_canvas_set_color(canvas, ColorWhite);
+    barcode_canvas_draw_box(canvas, 128 - width, 0, width, height);
+    barcode_canvas_set_color(canvas, ColorBlack);
+    barcode_canvas_draw_str_aligned(canvas, 128, 0, AlignRight, AlignTop, text);
 }
+#endif
 
-static void draw_codabar(Canvas* canvas, BarcodeData* barcode_data) {
-    FuriString* raw_data = barcode_data->raw_data;
-    FuriString* barcode_digits = barcode_data->correct_data;
-    //BarcodeTypeObj* type_obj = barcode_data->type_obj;
+void barcode_draw_callback(Canvas* canvas, void* ctx) {
+    furi_assert(ctx);
+    BarcodeModel* barcode_model = ctx;
+    BarcodeData* data = barcode_model->data;
+    BarcodeRender* render = &barcode_model->render;
 
-    int barcode_length = furi_string_size(barcode_digits);
-    int total_pixels = 0;
+    //the barcode is still being loaded on the load thread
+    if(barcode_model->loading || data == NULL) {
+        barcode_canvas_clear(canvas);
+        barcode_canvas_draw_str_aligned(canvas, 64, 32, AlignCenter, AlignCenter, "Loading...");
+        return;
+    }
 
-    for(int i = 0; i < barcode_length; i++) {
-        //1 for wide, 0 for narrow
-        char wide_or_narrow = furi_string_get_char(barcode_digits, i);
-        int wn_digit = wide_or_narrow - '0'; //wide(1) or narrow(0) digit
+#ifdef BARCODE_DEBUG
+    uint8_t trace_type = data->valid ? data->type_obj->type : BARCODE_TRACE_NO_TYPE;
+    size_t trace_length = data->raw_data != NULL ? furi_string_size(data->raw_data) : 0;
+    barcode_trace_begin(BarcodeTraceDraw, trace_type, trace_length);
+    uint32_t start_cycles = DWT->CYCCNT;
+#endif
 
-        if(wn_digit == 1) {
-            total_pixels += 3;
-        } else {
-            total_pixels += 1;
-        }
-        if((i + 1) % 7 == 0) {
-            total_pixels += 1;
+    barcode_canvas_clear(canvas);
+    if(data->valid) {
+        //the layout only has to be done on the first draw, after that it is only copied to the canvas
+        if(!render->ready) {
+            barcode_debug_memory_begin(BarcodeDebugPhaseFirstDraw);
+            build_render(render, data);
+            barcode_debug_memory_end(BarcodeDebugPhaseFirstDraw);
         }
+
+        bars_renderers[barcode_model->renderer](canvas, data, render);
+        draw_render_text(canvas, data, render);
+    } else {
+        draw_error_str(
+            canvas, get_error_code_name(data->reason), get_error_code_message(data->reason));
     }
 
-    int x = (128 - total_pixels) / 2;
-    int y = BARCODE_Y_START;
-    int width = 1;
-    int height = BARCODE_HEIGHT;
-    bool filled_in = true;
-
-    //set the canvas color to black to print the digit
-    canvas_set_color(canvas, ColorBlack);
-    // canvas_draw_str_aligned(canvas, 62, 30, AlignCenter, AlignCenter, error);
-    canvas_draw_str_aligned(
-        canvas, 62, y + height + 8, AlignCenter, AlignBottom, furi_string_get_cstr(raw_data));
-
-    for(int i = 0; i < barcode_length; i++) {
-        //1 for wide, 0 for narrow
-        char wide_or_narrow = furi_string_get_char(barcode_digits, i);
-        int wn_digit = wide_or_narrow - '0'; //wide(1) or narrow(0) digit
-
-        if(filled_in) {
-            if(wn_digit == 1) {
-                x = draw_bits(canvas, "111", x, y, width, height);
-            } else {
-                x = draw_bits(canvas, "1", x, y, width, height);
-            }
-            filled_in = false;
-        } else {
-            if(wn_digit == 1) {
-                x = draw_bits(canvas, "000", x, y, width, height);
-            } else {
-                x = draw_bits(canvas, "0", x, y, width, height);
-            }
-            filled_in = true;
-        }
-        if((i + 1) % 7 == 0) {
-            x = draw_bits(canvas, "0", x, y, width, height);
-            filled_in = true;
+#ifdef BARCODE_DEBUG
+    //the overlay is only drawn when it is on, so the frames are the same as without it
+    if(barcode_model->overlay.enabled) {
+        draw_overlay(canvas, &barcode_model->overlay, DWT->CYCCNT - start_cycles);
+    }
+    barcode_trace_end(BarcodeTraceDraw, trace_type, trace_length);
+#endif
+}
+
+#ifdef BARCODE_DEBUG
+/**
+ * @returns the length of the longest start of keys that also ends the first matched keys, shorter than matched
+ * This is the prefix function of the keys, the keys that were pressed may still be the start of the keys
+*/
+static uint8_t trace_keys_fallback(const InputKey* keys, uint8_t matched) {
+    for(uint8_t length = matched - 1; length > 0; length--) {
+        if(memcmp(keys, keys + matched - length, length * sizeof(InputKey)) == 0) {
+            return length;
         }
     }
+    return 0;
 }
 
-static void barcode_draw_callback(Canvas* canvas, void* ctx) {
-    furi_assert(ctx);
-    BarcodeModel* barcode_model = ctx;
-    BarcodeData* data = barcode_model->data;
-    // const char* barcode_digits =;
+/**
+ * Writes the timing trace when the last of the BARCODE_TRACE_KEYS is pressed
+*/
+static void check_trace_keys(Barcode* barcode, InputEvent* input_event) {
+    static const InputKey trace_keys[] = BARCODE_TRACE_KEYS;
+    if(input_event->type != InputTypeShort) {
+        return;
+    }
 
-    canvas_clear(canvas);
-    if(data->valid) {
-        switch(data->type_obj->type) {
-        case UPCA:
-            draw_upc_a(canvas, data);
-            break;
-        case EAN8:
-            draw_ean_8(canvas, data);
-            break;
-        case EAN13:
-            draw_ean_13(canvas, data);
-            break;
-        case CODE39:
-            draw_code_39(canvas, data);
-            break;
-        case CODE128:
-        case CODE128C:
-            draw_code_128(canvas, data);
-            break;
-        case CODABAR:
-            draw_codabar(canvas, data);
-            break;
-        case UNKNOWN:
-        default:
-            break;
-        }
-    } else {
-        draw_error_str(
-            canvas, get_error_code_name(data->reason), get_error_code_message(data->reason));
+    //falls back to shorter starts of the keys until the key continues one, so Up Up Up Down Down matches
+    while(barcode->trace_keys > 0 && input_event->key != trace_keys[barcode->trace_keys]) {
+        barcode->trace_keys = trace_keys_fallback(trace_keys, barcode->trace_keys);
+    }
+    if(input_event->key != trace_keys[barcode->trace_keys]) {
+        return;
+    }
+
+    barcode->trace_keys++;
+    if(barcode->trace_keys == COUNT_OF(trace_keys)) {
+        barcode->trace_keys = 0;
+        barcode_trace_flush();
     }
 }
+#endif
 
 bool barcode_input_callback(InputEvent* input_event, void* ctx) {
-    UNUSED(ctx);
-    //furi_assert(ctx);
-
-    //Barcode* test_view_object = ctx;
+    furi_assert(ctx);
+    Barcode* barcode = ctx;
+
+#ifdef BARCODE_DEBUG
+    check_trace_keys(barcode, input_event);
+
+    if(input_event->key == InputKeyOk && input_event->type == InputTypeLong) {
+        with_view_model(
+            barcode->view,
+            BarcodeModel * model,
+            {
+                model->overlay.enabled = !model->overlay.enabled;
+                model->overlay.redraws = 0;
+                memset(model->overlay.frame_us, 0, sizeof(model->overlay.frame_us));
+            },
+            true);
+    }
+#endif
 
     if(input_event->key == InputKeyBack) {
+        //leaving the view cancels the load, the previous view is opened by the view dispatcher
+        if(input_event->type == InputTypeShort) {
+            barcode_load_cancel(barcode->barcode_app);
+        }
         return false;
     } else {
         return true;
@@ -443,34 +416,73 @@ Barcode* barcode_view_allocate(BarcodeApp* barcode_app) {
 
     barcode->view = view_alloc();
     barcode->barcode_app = barcode_app;
+#ifdef BARCODE_DEBUG
+    barcode->trace_keys = 0;
+#endif
 
     view_set_context(barcode->view, barcode);
     view_allocate_model(barcode->view, ViewModelTypeLocking, sizeof(BarcodeModel));
     view_set_draw_callback(barcode->view, barcode_draw_callback);
     view_set_input_callback(barcode->view, barcode_input_callback);
 
+    with_view_model(
+        barcode->view,
+        BarcodeModel * model,
+        {
+            model->file_path = NULL;
+            model->data = NULL;
+            model->loading = false;
+            model->renderer = BARCODE_DEFAULT_RENDERER;
+        },
+        false);
+#ifdef BARCODE_DEBUG
+    with_view_model(
+        barcode->view, BarcodeModel * model, { model->overlay.enabled = false; }, false);
+#endif
+
     return barcode;
 }
 
-void barcode_free_model(Barcode* barcode) {
+/**
+ * Swaps the barcode of the view for another one in a single locked exchange, the previous barcode is
+ * freed after the lock is released so the draw callback never waits for it
+ * @param file_path  the path of the barcode file, copied, or NULL
+ * @param data  the barcode data from barcode_data_alloc, the view owns it now, or NULL
+*/
+void barcode_set_data(Barcode* barcode, FuriString* file_path, BarcodeData* data) {
+    FuriString* new_file_path = file_path != NULL ? furi_string_alloc_set(file_path) : NULL;
+    FuriString* old_file_path;
+    BarcodeData* old_data;
+
     with_view_model(
         barcode->view,
         BarcodeModel * model,
         {
-            if(model->file_path != NULL) {
-                furi_string_free(model->file_path);
-            }
-            if(model->data != NULL) {
-                if(model->data->raw_data != NULL) {
-                    furi_string_free(model->data->raw_data);
-                }
-                if(model->data->correct_data != NULL) {
-                    furi_string_free(model->data->correct_data);
-                }
-                free(model->data);
-            }
+            old_file_path = model->file_path;
+            old_data = model->data;
+            model->file_path = new_file_path;
+            model->data = data;
+            model->render.ready = false;
+            model->loading = false;
         },
-        false);
+        data != NULL);
+
+    if(old_file_path != NULL) {
+        furi_string_free(old_file_path);
+    }
+    barcode_data_free(old_data);
+}
+
+/**
+ * Shows that a barcode is being loaded instead of the barcode, or stops showing it
+*/
+void barcode_set_loading(Barcode* barcode, bool loading) {
+    with_view_model(
+        barcode->view, BarcodeModel * model, { model->loading = loading; }, loading);
+}
+
+void barcode_free_model(Barcode* barcode) {
+    barcode_set_data(barcode, NULL, NULL);
 }
 
 void barcode_free(Barcode* barcode) {
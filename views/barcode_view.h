@@ -4,18 +4,85 @@
 
 typedef struct BarcodeApp BarcodeApp;
 
+#ifdef BARCODE_DEBUG
+//the keys that write the timing trace to a file when they are pressed one after another in the barcode view
+#define BARCODE_TRACE_KEYS {InputKeyUp, InputKeyUp, InputKeyDown, InputKeyDown}
+#endif
+
 typedef struct {
     View* view;
     BarcodeApp* barcode_app;
+#ifdef BARCODE_DEBUG
+    uint8_t trace_keys; //the number of BARCODE_TRACE_KEYS that were pressed in a row
+#endif
 } Barcode;
 
+typedef enum {
+    BarcodeRendererBoxes, //draws one canvas box per bar
+    BarcodeRendererRowBitmap, //builds one row bitmap and copies it into every row of the bars
+} BarcodeRenderer;
+
+//the renderer used to draw the bars, BarcodeRendererBoxes is kept for comparison
+#ifndef BARCODE_DEFAULT_RENDERER
+#define BARCODE_DEFAULT_RENDERER BarcodeRendererRowBitmap
+#endif
+
+//the most digits that are drawn underneath a barcode (EAN-13)
+#define BARCODE_MAX_DIGITS 13
+
+typedef struct {
+    int x; //the x coordinate of the digit
+    char text[2]; //the digit as a string so it can be printed
+} BarcodeRenderDigit;
+
+/**
+ * Everything needed to draw a loaded barcode, built by the first draw and reused until the model is freed
+*/
+typedef struct {
+    bool ready; //false until the render has been built
+    int x; //the x coordinate of the first module
+    uint8_t row[BARCODE_ROW_BYTES]; //xbm bitmap of one row of the bars
+    uint8_t guard_row[BARCODE_ROW_BYTES]; //xbm bitmap of the guard bars that extend below the rest of the bars
+    bool has_guards; //true if the guard_row has to be drawn
+    int digit_count; //the number of digits drawn under an EAN/UPC barcode, 0 to draw the data centered instead
+    BarcodeRenderDigit digits[BARCODE_MAX_DIGITS];
+} BarcodeRender;
+
+#ifdef BARCODE_DEBUG
+//the number of frames the overlay shows the longest draw time of
+#define BARCODE_OVERLAY_FRAMES 32
+
+/**
+ * The frame time overlay of debug builds, turned on and off by holding OK in the barcode view
+*/
+typedef struct {
+    bool enabled;
+    uint32_t redraws; //the number of frames drawn since the overlay was turned on
+    uint32_t frame_us[BARCODE_OVERLAY_FRAMES]; //the draw times of the last frames, the last one is at redraws
+} BarcodeOverlay;
+#endif
+
 typedef struct {
     FuriString* file_path;
     BarcodeData* data;
+    bool loading; //true while the barcode is loaded on the load thread, data is the previous barcode
+    BarcodeRenderer renderer;
+    BarcodeRender render; //the cached render of data
+#ifdef BARCODE_DEBUG
+    BarcodeOverlay overlay;
+#endif
 } BarcodeModel;
 
 Barcode* barcode_view_allocate(BarcodeApp* barcode_app);
 
+void barcode_draw_callback(Canvas* canvas, void* ctx);
+
+bool barcode_input_callback(InputEvent* input_event, void* ctx);
+
+void barcode_set_data(Barcode* barcode, FuriString* file_path, BarcodeData* data);
+
+void barcode_set_loading(Barcode* barcode, bool loading);
+
 void barcode_free_model(Barcode* barcode);
 
 void barcode_free(Barcode* barcode);
@@ -62,12 +62,12 @@ void draw_button(Canvas* const canvas, const char* text, int y, bool selected) {
     canvas_set_color(canvas, ColorBlack);
 }
 
-static void app_draw_callback(Canvas* canvas, void* ctx) {
+void create_view_draw_callback(Canvas* canvas, void* ctx) {
     furi_assert(ctx);
 
     CreateViewModel* create_view_model = ctx;
 
-    BarcodeTypeObj* type_obj = create_view_model->barcode_type;
+    const BarcodeTypeObj* type_obj = create_view_model->barcode_type;
     if(create_view_model->barcode_type == NULL) {
         return;
     }
@@ -160,14 +160,14 @@ void text_input_callback(void* ctx) {
                 furi_string_set_str(model->barcode_data, create_view_object->input);
             }
         },
-        true);
+        false); //switching back to the create view draws it
 
                 text_input_show_illegal_symbols(create_view_object->barcode_app->text_input, true);
     view_dispatcher_switch_to_view(
         create_view_object->barcode_app->view_dispatcher, CreateBarcodeView);
 }
 
-static bool app_input_callback(InputEvent* input_event, void* ctx) {
+bool create_view_input_callback(InputEvent* input_event, void* ctx) {
     furi_assert(ctx);
 
     if(input_event->key == InputKeyBack) {
@@ -177,23 +177,12 @@ static bool app_input_callback(InputEvent* input_event, void* ctx) {
     CreateView* create_view_object = ctx;
 
     //get the currently selected menu item from the model
-    int selected_menu_item = 0;
-    BarcodeTypeObj* barcode_type = NULL;
-    FuriString* file_name;
-    FuriString* barcode_data;
-    CreateMode mode;
-
-    with_view_model(
-        create_view_object->view,
-        CreateViewModel * model,
-        {
-            selected_menu_item = model->selected_menu_item;
-            barcode_type = model->barcode_type;
-            file_name = model->file_name;
-            barcode_data = model->barcode_data;
-            mode = model->mode;
-        },
-        true);
+    CreateViewModel current = create_view_read_model(create_view_object);
+    int selected_menu_item = current.selected_menu_item;
+    const BarcodeTypeObj* barcode_type = current.barcode_type;
+    FuriString* file_name = current.file_name;
+    FuriString* barcode_data = current.barcode_data;
+    CreateMode mode = current.mode;
 
     int total_menu_items = mode == EditMode ? TOTAL_MENU_ITEMS : TOTAL_MENU_ITEMS - 1;
 
@@ -205,13 +194,13 @@ static bool app_input_callback(InputEvent* input_event, void* ctx) {
         } else if(input_event->key == InputKeyLeft) {
             if(selected_menu_item == TypeMenuItem && barcode_type != NULL) { //Select Barcode Type
                 if(barcode_type->type > 0) {
-                    barcode_type = barcode_type_objs[barcode_type->type - 1];
+                    barcode_type = &barcode_type_objs[barcode_type->type - 1];
                 }
             }
         } else if(input_event->key == InputKeyRight) {
             if(selected_menu_item == TypeMenuItem && barcode_type != NULL) { //Select Barcode Type
                 if(barcode_type->type < NUMBER_OF_BARCODE_TYPES - 2) {
-                    barcode_type = barcode_type_objs[barcode_type->type + 1];
+                    barcode_type = &barcode_type_objs[barcode_type->type + 1];
                 }
             }
         } else if(input_event->key == InputKeyOk) {
@@ -273,15 +262,18 @@ static bool app_input_callback(InputEvent* input_event, void* ctx) {
         }
     }
 
-    //change the currently selected menu item
-    with_view_model(
-        create_view_object->view,
-        CreateViewModel * model,
-        {
-            model->selected_menu_item = selected_menu_item;
-            model->barcode_type = barcode_type;
-        },
-        true);
+    //change the currently selected menu item, the view is only redrawn if the key changed something
+    //so a key press (press, short and release) draws the view at most once
+    if(selected_menu_item != current.selected_menu_item || barcode_type != current.barcode_type) {
+        with_view_model(
+            create_view_object->view,
+            CreateViewModel * model,
+            {
+                model->selected_menu_item = selected_menu_item;
+                model->barcode_type = barcode_type;
+            },
+            true);
+    }
 
     return true;
 }
@@ -296,12 +288,23 @@ CreateView* create_view_allocate(BarcodeApp* barcode_app) {
 
     view_set_context(create_view_object->view, create_view_object);
     view_allocate_model(create_view_object->view, ViewModelTypeLocking, sizeof(CreateViewModel));
-    view_set_draw_callback(create_view_object->view, app_draw_callback);
-    view_set_input_callback(create_view_object->view, app_input_callback);
+    view_set_draw_callback(create_view_object->view, create_view_draw_callback);
+    view_set_input_callback(create_view_object->view, create_view_input_callback);
 
     return create_view_object;
 }
 
+/**
+ * Reads the model without redrawing the view, the strings are still owned by the model
+ * @returns a copy of the model
+*/
+CreateViewModel create_view_read_model(CreateView* create_view_object) {
+    CreateViewModel copy;
+    with_view_model(
+        create_view_object->view, CreateViewModel * model, { copy = *model; }, false);
+    return copy;
+}
+
 void create_view_free_model(CreateView* create_view_object) {
     with_view_model(
         create_view_object->view,
@@ -317,38 +320,35 @@ void create_view_free_model(CreateView* create_view_object) {
                 furi_string_free(model->barcode_data);
             }
         },
-        true);
+        false);
 }
 
 void remove_barcode(CreateView* create_view_object) {
+    barcode_trace_begin(BarcodeTraceRemove, BARCODE_TRACE_NO_TYPE, 0);
     Storage* storage = furi_record_open(RECORD_STORAGE);
 
     bool success = false;
 
-    with_view_model(
-        create_view_object->view,
-        CreateViewModel * model,
-        {
-            FURI_LOG_I(TAG, "Attempting to remove file");
-            if(model->file_path != NULL) {
-                FURI_LOG_I(TAG, "Removing File: %s", furi_string_get_cstr(model->file_path));
-                if(storage_simply_remove(storage, furi_string_get_cstr(model->file_path))) {
-                    FURI_LOG_I(
-                        TAG,
-                        "File: \"%s\" was successfully removed",
-                        furi_string_get_cstr(model->file_path));
-                    success = true;
-                } else {
-                    FURI_LOG_E(TAG, "Unable to remove file!");
-                    success = false;
-                }
-            } else {
-                FURI_LOG_E(TAG, "Could not remove barcode file");
-                success = false;
-            }
-        },
-        true);
+    //the file is removed without holding the model lock so drawing the view doesn't wait for the storage
+    FuriString* file_path = create_view_read_model(create_view_object).file_path;
+
+    BARCODE_LOG_I("Attempting to remove file");
+    if(file_path != NULL) {
+        BARCODE_LOG_I("Removing File: %s", furi_string_get_cstr(file_path));
+        if(storage_simply_remove(storage, furi_string_get_cstr(file_path))) {
+            BARCODE_LOG_I(
+                "File: \"%s\" was successfully removed", furi_string_get_cstr(file_path));
+            success = true;
+        } else {
+            BARCODE_LOG_E("Unable to remove file!");
+            success = false;
+        }
+    } else {
+        BARCODE_LOG_E("Could not remove barcode file");
+        success = false;
+    }
     furi_record_close(RECORD_STORAGE);
+    barcode_trace_end(BarcodeTraceRemove, BARCODE_TRACE_NO_TYPE, 0);
 
     with_view_model(
         create_view_object->barcode_app->message_view->view,
@@ -360,45 +360,35 @@ void remove_barcode(CreateView* create_view_object) {
                 model->message = "Could not delete file";
             }
         },
-        true);
+        false); //switching to the message view draws it
 
     view_dispatcher_switch_to_view(
         create_view_object->barcode_app->view_dispatcher, MessageErrorView);
 }
 
 void save_barcode(CreateView* create_view_object) {
-    BarcodeTypeObj* barcode_type = NULL;
-    FuriString* file_path; //this may be empty
-    FuriString* file_name;
-    FuriString* barcode_data;
-    CreateMode mode;
-
-    with_view_model(
-        create_view_object->view,
-        CreateViewModel * model,
-        {
-            file_path = model->file_path;
-            file_name = model->file_name;
-            barcode_data = model->barcode_data;
-            barcode_type = model->barcode_type;
-            mode = model->mode;
-        },
-        true);
+    CreateViewModel current = create_view_read_model(create_view_object);
+    const BarcodeTypeObj* barcode_type = current.barcode_type;
+    FuriString* file_path = current.file_path; //this may be empty
+    FuriString* file_name = current.file_name;
+    FuriString* barcode_data = current.barcode_data;
+    CreateMode mode = current.mode;
 
     if(file_name == NULL || furi_string_empty(file_name)) {
-        FURI_LOG_E(TAG, "File Name cannot be empty");
+        BARCODE_LOG_E("File Name cannot be empty");
         return;
     }
     if(barcode_data == NULL || furi_string_empty(barcode_data)) {
-        FURI_LOG_E(TAG, "Barcode Data cannot be empty");
+        BARCODE_LOG_E("Barcode Data cannot be empty");
         return;
     }
     if(barcode_type == NULL) {
-        FURI_LOG_E(TAG, "Type not defined");
+        BARCODE_LOG_E("Type not defined");
         return;
     }
 
     bool success = false;
+    barcode_trace_begin(BarcodeTraceSave, barcode_type->type, furi_string_size(barcode_data));
 
     FuriString* full_file_path = furi_string_alloc_set(DEFAULT_USER_BARCODES);
     furi_string_push_back(full_file_path, '/');
@@ -415,9 +405,9 @@ void save_barcode(CreateView* create_view_object) {
                     furi_string_get_cstr(file_path),
                     furi_string_get_cstr(full_file_path));
                 if(error != FSE_OK) {
-                    FURI_LOG_E(TAG, "Rename error: %s", storage_error_get_desc(error));
+                    BARCODE_LOG_E("Rename error: %s", storage_error_get_desc(error));
                 } else {
-                    FURI_LOG_I(TAG, "Rename Success");
+                    BARCODE_LOG_I("Rename Success");
                 }
             }
         }
@@ -425,7 +415,7 @@ void save_barcode(CreateView* create_view_object) {
 
     FlipperFormat* ff = flipper_format_file_alloc(storage);
 
-    FURI_LOG_I(TAG, "Saving Barcode to: %s", furi_string_get_cstr(full_file_path));
+    BARCODE_LOG_I("Saving Barcode to: %s", furi_string_get_cstr(full_file_path));
 
     bool file_opened_status = false;
     if(mode == NewMode) {
@@ -456,12 +446,13 @@ void save_barcode(CreateView* create_view_object) {
 
         success = true;
     } else {
-        FURI_LOG_E(TAG, "Save error");
+        BARCODE_LOG_E("Save error");
         success = false;
     }
     furi_string_free(full_file_path);
     flipper_format_free(ff);
     furi_record_close(RECORD_STORAGE);
+    barcode_trace_end(BarcodeTraceSave, barcode_type->type, furi_string_size(barcode_data));
 
     with_view_model(
         create_view_object->barcode_app->message_view->view,
@@ -473,7 +464,7 @@ void save_barcode(CreateView* create_view_object) {
                 model->message = "A saving error has occurred";
             }
         },
-        true);
+        false); //switching to the message view draws it
 
     view_dispatcher_switch_to_view(
         create_view_object->barcode_app->view_dispatcher, MessageErrorView);
@@ -27,7 +27,7 @@ typedef struct {
     int selected_menu_item;
 
     CreateMode mode;
-    BarcodeTypeObj* barcode_type;
+    const BarcodeTypeObj* barcode_type;
     FuriString* file_path; //the current file that is opened
     FuriString* file_name;
     FuriString* barcode_data;
@@ -35,10 +35,16 @@ typedef struct {
 
 CreateView* create_view_allocate(BarcodeApp* barcode_app);
 
+void create_view_draw_callback(Canvas* canvas, void* ctx);
+
+bool create_view_input_callback(InputEvent* input_event, void* ctx);
+
 void remove_barcode(CreateView* create_view_object);
 
 void save_barcode(CreateView* create_view_object);
 
+CreateViewModel create_view_read_model(CreateView* create_view_object);
+
 void create_view_free_model(CreateView* create_view_object);
 
 void create_view_free(CreateView* create_view_object);
@@ -1,7 +1,7 @@
 #include "../barcode_app.h"
 #include "message_view.h"
 
-static void app_draw_callback(Canvas* canvas, void* ctx) {
+void message_view_draw_callback(Canvas* canvas, void* ctx) {
     furi_assert(ctx);
 
     MessageViewModel* message_view_model = ctx;
@@ -47,7 +47,7 @@ MessageView* message_view_allocate(BarcodeApp* barcode_app) {
 
     view_set_context(message_view_object->view, message_view_object);
     view_allocate_model(message_view_object->view, ViewModelTypeLocking, sizeof(MessageViewModel));
-    view_set_draw_callback(message_view_object->view, app_draw_callback);
+    view_set_draw_callback(message_view_object->view, message_view_draw_callback);
     view_set_input_callback(message_view_object->view, app_input_callback);
 
     return message_view_object;
@@ -15,6 +15,8 @@ typedef struct {
 
 MessageView* message_view_allocate(BarcodeApp* barcode_app);
 
+void message_view_draw_callback(Canvas* canvas, void* ctx);
+
 void message_view_free_model(MessageView* message_view_object);
 
 void message_view_free(MessageView* message_view_object);